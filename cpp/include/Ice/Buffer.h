@@ -96,6 +96,12 @@ public:
             _size = n;
         }
 
+        //
+        // Same as resize but if the capacity must be increased, exactly n
+        // bytes are allocated instead of at least twice the capacity.
+        //
+        void resizeExact(size_type);
+
         void reset()
         {
             if(_size > 0 && _size * 2 < _capacity)
@@ -142,6 +148,7 @@ public:
         Container(const Container&);
         void operator=(const Container&);
         void reserve(size_type);
+        void setCapacity(size_type);
 
         pointer _buf;
         size_type _size;
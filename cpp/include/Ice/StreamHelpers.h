@@ -108,6 +108,19 @@ struct IsMap
     static const bool value = IsContainer<T>::value && sizeof(test<T>(0)) == sizeof(char);
 };
 
+//
+// Can sequences of the provided type be marshaled with a single copy?
+// slice2cpp specializes this template for fixed-length structs whose data
+// members are all byte, short, int, long, float or double values (or such
+// structs). The specialization checks that the C++ struct has no padding,
+// in which case its memory layout matches its encoding on little-endian hosts.
+//
+template<typename T>
+struct IsBulkStreamable
+{
+    static const bool value = false;
+};
+
 #ifdef ICE_CPP11_MAPPING
 
 //
@@ -459,9 +472,9 @@ struct StreamHelper<T, StreamHelperCategoryEnum>
     }
 };
 
-// Helper for sequences
-template<typename T>
-struct StreamHelper<T, StreamHelperCategorySequence>
+// Helper for sequences, marshals the elements one by one
+template<typename T, bool bulk>
+struct StreamSequenceHelper
 {
     template<class S> static inline void
     write(S* stream, const T& v)
@@ -485,6 +498,53 @@ struct StreamHelper<T, StreamHelperCategorySequence>
     }
 };
 
+#ifndef ICE_BIG_ENDIAN
+// Helper for vectors of bulk streamable elements, marshals the elements with a single copy
+template<typename T>
+struct StreamSequenceHelper< ::std::vector<T>, true>
+{
+    template<class S> static inline void
+    write(S* stream, const ::std::vector<T>& v)
+    {
+        stream->writeSize(static_cast<Int>(v.size()));
+        if(!v.empty())
+        {
+            stream->writeBlob(reinterpret_cast<const Byte*>(&v[0]), v.size() * sizeof(T));
+        }
+    }
+
+    template<class S> static inline void
+    read(S* stream, ::std::vector<T>& v)
+    {
+        Int sz = stream->readAndCheckSeqSize(static_cast<int>(sizeof(T)));
+        ::std::vector<T>(sz).swap(v);
+        if(sz > 0)
+        {
+            const Byte* p;
+            stream->readBlob(p, static_cast<size_t>(sz) * sizeof(T));
+            memcpy(&v[0], p, static_cast<size_t>(sz) * sizeof(T));
+        }
+    }
+};
+#endif
+
+// Helper for sequences
+template<typename T>
+struct StreamHelper<T, StreamHelperCategorySequence>
+{
+    template<class S> static inline void
+    write(S* stream, const T& v)
+    {
+        StreamSequenceHelper<T, IsBulkStreamable<typename T::value_type>::value>::write(stream, v);
+    }
+
+    template<class S> static inline void
+    read(S* stream, T& v)
+    {
+        StreamSequenceHelper<T, IsBulkStreamable<typename T::value_type>::value>::read(stream, v);
+    }
+};
+
 // Helper for array custom sequence parameters
 template<typename T>
 struct StreamHelper<std::pair<const T*, const T*>, StreamHelperCategorySequence>
@@ -117,32 +117,44 @@ IceInternal::Buffer::Container::clear()
     _owned = true;
 }
 
+void
+IceInternal::Buffer::Container::resizeExact(size_type n)
+{
+    if(n == 0)
+    {
+        clear();
+    }
+    else if(n > _capacity)
+    {
+        setCapacity(n);
+    }
+    _size = n;
+}
+
 void
 IceInternal::Buffer::Container::reserve(size_type n)
 {
-    size_type c = _capacity;
     if(n > _capacity)
     {
-        _capacity = std::max<size_type>(n, 2 * _capacity);
-        _capacity = std::max<size_type>(static_cast<size_type>(240), _capacity);
+        setCapacity(std::max<size_type>(static_cast<size_type>(240), std::max<size_type>(n, 2 * _capacity)));
     }
     else if(n < _capacity)
     {
-        _capacity = n;
-    }
-    else
-    {
-        return;
+        setCapacity(n);
     }
+}
 
+void
+IceInternal::Buffer::Container::setCapacity(size_type n)
+{
     pointer p;
     if(_owned)
     {
-        p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
+        p = reinterpret_cast<pointer>(::realloc(_buf, n));
     }
     else
     {
-        p = reinterpret_cast<pointer>(::malloc(_capacity));
+        p = reinterpret_cast<pointer>(::malloc(n));
         if(p)
         {
             ::memcpy(p, _buf, _size);
@@ -152,9 +164,9 @@ IceInternal::Buffer::Container::reserve(size_type n)
 
     if(!p)
     {
-        _capacity = c; // Restore the previous capacity.
         throw std::bad_alloc();
     }
 
     _buf = p;
+    _capacity = n;
 }
@@ -46,6 +46,11 @@ namespace
 
 const ::std::string flushBatchRequests_name = "flushBatchRequests";
 
+//
+// Messages larger than this are read in chunks of increasing size, see message().
+//
+const Int readChunkSizeMin = 1024 * 1024;
+
 class TimeoutCallback : public IceUtil::TimerTask
 {
 public:
@@ -1679,9 +1684,22 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                     {
                         Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
                     }
+                    _readStreamSize = size;
                     if(size > static_cast<Int>(_readStream.b.size()))
                     {
-                        _readStream.b.resize(size);
+                        //
+                        // With stream transports, the buffer of large messages is grown as the
+                        // message data is received rather than allocated up-front with the size
+                        // announced by the header.
+                        //
+                        if(!_endpoint->datagram() && size - pos > readChunkSizeMin)
+                        {
+                            _readStream.b.resize(pos + readChunkSizeMin);
+                        }
+                        else
+                        {
+                            _readStream.b.resize(size);
+                        }
                     }
                     _readStream.i = _readStream.b.begin() + pos;
                 }
@@ -1694,6 +1712,19 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                     }
                     continue;
                 }
+                else if(static_cast<Int>(_readStream.b.size()) < _readStreamSize)
+                {
+                    //
+                    // The current chunk is fully read, grow the buffer for the next chunk. The
+                    // chunk size doubles with the amount of data already received to keep the
+                    // number of re-allocations logarithmic with the message size. The buffer is
+                    // grown exactly, its capacity never exceeds the message size.
+                    //
+                    ptrdiff_t pos = _readStream.i - _readStream.b.begin();
+                    _readStream.b.resizeExact(static_cast<size_t>(min<ptrdiff_t>(_readStreamSize, 2 * pos)));
+                    _readStream.i = _readStream.b.begin() + pos;
+                    continue;
+                }
                 break;
             }
 
@@ -2248,6 +2279,7 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
+    _readStreamSize(0),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
     _dispatchCount(0),
     _state(StateNotInitialized),
@@ -2940,8 +2972,22 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
     if(!_sendStreams.empty())
     {
-        _sendStreams.push_back(message);
-        _sendStreams.back().adopt(0);
+        //
+        // Heartbeats are queued ahead of the requests and replies waiting to be sent, after
+        // the message being sent and the heartbeats already queued. Otherwise, large messages
+        // could hold back a heartbeat long enough for the peer's ACM to close the connection.
+        //
+        deque<OutgoingMessage>::iterator p = _sendStreams.end();
+        if(message.stream->b[8] == validateConnectionMsg)
+        {
+            p = _sendStreams.begin() + 1;
+            while(p != _sendStreams.end() && p->stream->b[8] == validateConnectionMsg)
+            {
+                ++p;
+            }
+        }
+        p = _sendStreams.insert(p, message);
+        p->adopt(0);
         return AsyncStatusQueued;
     }
 
@@ -376,6 +376,7 @@ private:
 
     Ice::InputStream _readStream;
     bool _readHeader;
+    Int _readStreamSize;
     Ice::OutputStream _writeStream;
 
     Observer _observer;
@@ -19,6 +19,9 @@
 #include <Ice/Functional.h>
 #include <Ice/Properties.h>
 #include <Ice/Comparable.h>
+#include <Ice/Communicator.h>
+#include <Ice/ObjectAdapter.h>
+#include <Ice/Connection.h>
 #include <iterator>
 
 using namespace std;
@@ -125,10 +128,111 @@ public:
     }
 };
 
+class LocatorCacheObserverI : public Ice::LocatorCacheObserver
+{
+public:
+
+    LocatorCacheObserverI(const LocatorTablePtr& table, const InstancePtr& instance) :
+        _table(table),
+        _instance(instance)
+    {
+    }
+
+#ifdef ICE_CPP11_MAPPING
+    virtual void adapterChanged(string id, const Current&) override
+#else
+    virtual void adapterChanged(const string& id, const Current&)
+#endif
+    {
+        _table->adapterChanged(id);
+        if(_instance->traceLevels()->location >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+            out << "locator notified adapter change, removed endpoints from locator table\nadapter = " << id;
+        }
+    }
+
+#ifdef ICE_CPP11_MAPPING
+    virtual void objectChanged(Identity id, const Current&) override
+#else
+    virtual void objectChanged(const Identity& id, const Current&)
+#endif
+    {
+        _table->objectChanged(id);
+        if(_instance->traceLevels()->location >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->locationCat);
+            out << "locator notified object change, removed object from locator table\nobject = "
+                << Ice::identityToString(id, _instance->toStringMode());
+        }
+    }
+
+private:
+
+    const LocatorTablePtr _table;
+    const InstancePtr _instance;
+};
+
+class AddObserverCallback : public IceUtil::Shared
+{
+public:
+
+    AddObserverCallback(const LocatorInfoPtr& locatorInfo, const Ice::ConnectionPtr& connection) :
+        _locatorInfo(locatorInfo),
+        _connection(connection)
+    {
+    }
+
+    void response()
+    {
+        _locatorInfo->addObserverResponse(_connection);
+    }
+
+    void exception(const Ice::Exception& ex)
+    {
+        _locatorInfo->addObserverException(ex);
+    }
+
+private:
+
+    const LocatorInfoPtr _locatorInfo;
+    const Ice::ConnectionPtr _connection;
+};
+typedef IceUtil::Handle<AddObserverCallback> AddObserverCallbackPtr;
+
+//
+// The identifier of the connection used by the locator to call the
+// locator cache observer.
+//
+const string observerConnectionId = "ice.locatorCacheObserver";
+
+#ifndef ICE_CPP11_MAPPING
+class ObserverCloseCallback : public Ice::CloseCallback
+{
+public:
+
+    ObserverCloseCallback(const LocatorInfoPtr& locatorInfo) :
+        _locatorInfo(locatorInfo)
+    {
+    }
+
+    virtual void
+    closed(const Ice::ConnectionPtr& connection)
+    {
+        _locatorInfo->observerClosed(connection);
+    }
+
+private:
+
+    const LocatorInfoPtr _locatorInfo;
+};
+#endif
+
 }
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _notifications(properties->getPropertyAsInt("Ice.LocatorCacheNotifications") > 0),
     _tableHint(_table.end())
 {
 }
@@ -199,7 +303,8 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         _tableHint = _table.insert(_tableHint,
                                    pair<const LocatorPrxPtr, LocatorInfoPtr>(locator,
                                                                           new LocatorInfo(locator, t->second,
-                                                                                          _background)));
+                                                                                          _background,
+                                                                                          _notifications)));
     }
     else
     {
@@ -209,7 +314,7 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+IceInternal::LocatorTable::LocatorTable() : _changes(0)
 {
 }
 
@@ -220,6 +325,7 @@ IceInternal::LocatorTable::clear()
 
      _adapterEndpointsMap.clear();
      _objectMap.clear();
+     ++_changes;
 }
 
 bool
@@ -243,10 +349,16 @@ IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, v
 }
 
 void
-IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vector<EndpointIPtr>& endpoints)
+IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vector<EndpointIPtr>& endpoints,
+                                               Ice::Long changes)
 {
     IceUtil::Mutex::Lock sync(*this);
 
+    if(changes != _changes) // The endpoints might have changed since the locator returned them.
+    {
+        return;
+    }
+
     map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
 
     if(p != _adapterEndpointsMap.end())
@@ -299,10 +411,15 @@ IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, Refer
 }
 
 void
-IceInternal::LocatorTable::addObjectReference(const Identity& id, const ReferencePtr& ref)
+IceInternal::LocatorTable::addObjectReference(const Identity& id, const ReferencePtr& ref, Ice::Long changes)
 {
     IceUtil::Mutex::Lock sync(*this);
 
+    if(changes != _changes) // The object might have changed since the locator returned it.
+    {
+        return;
+    }
+
     map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
 
     if(p != _objectMap.end())
@@ -331,6 +448,29 @@ IceInternal::LocatorTable::removeObjectReference(const Identity& id)
     return ref;
 }
 
+void
+IceInternal::LocatorTable::adapterChanged(const string& adapter)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _adapterEndpointsMap.erase(adapter);
+    ++_changes;
+}
+
+void
+IceInternal::LocatorTable::objectChanged(const Identity& id)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _objectMap.erase(id);
+    ++_changes;
+}
+
+Ice::Long
+IceInternal::LocatorTable::getChanges()
+{
+    IceUtil::Mutex::Lock sync(*this);
+    return _changes;
+}
+
 bool
 IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
 {
@@ -447,7 +587,7 @@ IceInternal::LocatorInfo::Request::addCallback(const ReferencePtr& ref,
 }
 
 IceInternal::LocatorInfo::Request::Request(const LocatorInfoPtr& locatorInfo, const ReferencePtr& ref) :
-    _locatorInfo(locatorInfo), _ref(ref), _sent(false), _response(false)
+    _locatorInfo(locatorInfo), _ref(ref), _changes(locatorInfo->_table->getChanges()), _sent(false), _response(false)
 {
 }
 
@@ -456,7 +596,7 @@ IceInternal::LocatorInfo::Request::response(const Ice::ObjectPrxPtr& proxy)
 {
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
-        _locatorInfo->finishRequest(_ref, _wellKnownRefs, proxy, false);
+        _locatorInfo->finishRequest(_ref, _wellKnownRefs, proxy, false, _changes);
         _response = true;
         _proxy = proxy;
         _monitor.notifyAll();
@@ -472,7 +612,7 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
 {
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
-        _locatorInfo->finishRequest(_ref, _wellKnownRefs, 0, dynamic_cast<const Ice::UserException*>(&ex));
+        _locatorInfo->finishRequest(_ref, _wellKnownRefs, 0, dynamic_cast<const Ice::UserException*>(&ex), _changes);
 
         ICE_SET_EXCEPTION_FROM_CLONE(_exception, ex.ice_clone());
         _monitor.notifyAll();
@@ -483,10 +623,15 @@ IceInternal::LocatorInfo::Request::exception(const Ice::Exception& ex)
     }
 }
 
-IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background) :
+IceInternal::LocatorInfo::LocatorInfo(const LocatorPrxPtr& locator, const LocatorTablePtr& table, bool background,
+                                      bool notifications) :
     _locator(locator),
     _table(table),
-    _background(background)
+    _background(background),
+    _notifications(notifications),
+    _notificationsUnsupported(false),
+    _addingObserver(false),
+    _observerActive(0)
 {
     assert(_locator);
     assert(_table);
@@ -499,6 +644,18 @@ IceInternal::LocatorInfo::destroy()
 
     _locatorRegistry = 0;
     _table->clear();
+
+    //
+    // The observer adapter is destroyed with the communicator.
+    //
+    _observerActive.exchange(0);
+    if(_observerConnection)
+    {
+        _observerConnection->setCloseCallback(ICE_NULLPTR);
+    }
+    _observerConnection = 0;
+    _observerAdapter = 0;
+    _observer = 0;
 }
 
 bool
@@ -554,6 +711,11 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref,
                                        const GetEndpointsCallbackPtr& callback)
 {
     assert(ref->isIndirect());
+    if(_notifications && ttl != 0 && checkObserver())
+    {
+        ttl = -1; // The locator notifies the changes, the cached results don't expire.
+    }
+
     vector<EndpointIPtr> endpoints;
     if(!ref->isWellKnown())
     {
@@ -642,6 +804,226 @@ IceInternal::LocatorInfo::clearCache(const ReferencePtr& ref)
     }
 }
 
+void
+IceInternal::LocatorInfo::addObserver(const Ice::ConnectionPtr& connection)
+{
+    if(!connection)
+    {
+        //
+        // The locator is collocated, it can't call the observer.
+        //
+        IceUtil::Mutex::Lock sync(*this);
+        _addingObserver = false;
+        _notificationsUnsupported = true;
+        return;
+    }
+
+    try
+    {
+        Ice::ObjectAdapterPtr adapter;
+        Ice::ObjectPrxPtr observer;
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            if(!_observerAdapter)
+            {
+                _observerAdapter = _locator->ice_getCommunicator()->createObjectAdapter("");
+                _observer = _observerAdapter->addWithUUID(
+                    ICE_MAKE_SHARED(LocatorCacheObserverI, _table, _locator->_getReference()->getInstance()));
+                _observerAdapter->activate();
+            }
+            adapter = _observerAdapter;
+            observer = _observer;
+        }
+
+        //
+        // The locator calls the observer over this connection, it must
+        // not be closed by ACM when idle. The connection is dedicated to
+        // the observer, the adapter and ACM settings of the connections
+        // used by the application aren't changed.
+        //
+        connection->setAdapter(adapter);
+        connection->setACM(IceUtil::None, Ice::ICE_ENUM(ACMClose, CloseOff),
+                           Ice::ICE_ENUM(ACMHeartbeat, HeartbeatAlways));
+
+        LocatorCacheNotifierPrxPtr notifier = ICE_UNCHECKED_CAST(LocatorCacheNotifierPrx,
+            connection->createProxy(_locator->ice_getIdentity())->ice_facet("LocatorCache"));
+        AddObserverCallbackPtr cb = new AddObserverCallback(this, connection);
+#ifdef ICE_CPP11_MAPPING
+        notifier->addObserverAsync(ICE_UNCHECKED_CAST(LocatorCacheObserverPrx, observer),
+            [cb]()
+            {
+                cb->response();
+            },
+            [cb](exception_ptr e)
+            {
+                try
+                {
+                    rethrow_exception(e);
+                }
+                catch(const Exception& ex)
+                {
+                    cb->exception(ex);
+                }
+            });
+#else
+        notifier->begin_addObserver(LocatorCacheObserverPrx::uncheckedCast(observer),
+                                    newCallback_LocatorCacheNotifier_addObserver(cb,
+                                                                                 &AddObserverCallback::response,
+                                                                                 &AddObserverCallback::exception));
+#endif
+    }
+    catch(const Ice::Exception& ex)
+    {
+        addObserverException(ex);
+    }
+}
+
+void
+IceInternal::LocatorInfo::addObserverResponse(const Ice::ConnectionPtr& connection)
+{
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        _addingObserver = false;
+        _observerConnection = connection;
+
+        //
+        // The changes made before the observer was added aren't notified,
+        // the results cached until now might be stale.
+        //
+        _table->clear();
+        _observerActive.exchange(1);
+
+        InstancePtr instance = _locator->_getReference()->getInstance();
+        if(instance->traceLevels()->location >= 1)
+        {
+            Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+            out << "added locator cache observer\nlocator = " << _locator;
+        }
+    }
+
+    //
+    // The close callback is set without the mutex locked, it's called
+    // right away if the connection is already closed.
+    //
+#ifdef ICE_CPP11_MAPPING
+    LocatorInfoPtr self = this;
+    connection->setCloseCallback([self](const Ice::ConnectionPtr& c)
+                                 {
+                                     self->observerClosed(c);
+                                 });
+#else
+    connection->setCloseCallback(new ObserverCloseCallback(this));
+#endif
+}
+
+void
+IceInternal::LocatorInfo::observerClosed(const Ice::ConnectionPtr& connection)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    if(_observerConnection != connection)
+    {
+        return;
+    }
+
+    //
+    // Changes might not have been notified while the connection was
+    // closing. The cached results are cleared and the observer is
+    // added again with the next locator request.
+    //
+    _observerActive.exchange(0);
+    _observerConnection = 0;
+    _table->clear();
+}
+
+void
+IceInternal::LocatorInfo::addObserverException(const Ice::Exception& ex)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    _addingObserver = false;
+
+    try
+    {
+        ex.ice_throw();
+    }
+    catch(const FacetNotExistException&)
+    {
+        _notificationsUnsupported = true; // The locator doesn't support locator cache notifications.
+    }
+    catch(const OperationNotExistException&)
+    {
+        _notificationsUnsupported = true;
+    }
+    catch(const Ice::Exception&)
+    {
+        // The observer will be added again with the next locator request.
+    }
+
+    InstancePtr instance = _locator->_getReference()->getInstance();
+    if(instance->traceLevels()->location >= 1)
+    {
+        Trace out(instance->initializationData().logger, instance->traceLevels()->locationCat);
+        out << "couldn't add locator cache observer\nlocator = " << _locator << "\nreason = " << ex;
+    }
+}
+
+bool
+IceInternal::LocatorInfo::checkObserver()
+{
+    //
+    // The flag is reset by the close callback of the observer
+    // connection.
+    //
+    if(_observerActive.load() > 0)
+    {
+        return true;
+    }
+
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_observerConnection)
+        {
+            return true;
+        }
+
+        if(_notificationsUnsupported || _addingObserver)
+        {
+            return false;
+        }
+        _addingObserver = true;
+    }
+
+    try
+    {
+#ifdef ICE_CPP11_MAPPING
+        LocatorInfoPtr self = this;
+        _locator->ice_connectionId(observerConnectionId)->ice_getConnectionAsync(
+            [self](const Ice::ConnectionPtr& connection)
+            {
+                self->addObserver(connection);
+            },
+            [self](exception_ptr e)
+            {
+                try
+                {
+                    rethrow_exception(e);
+                }
+                catch(const Exception& ex)
+                {
+                    self->addObserverException(ex);
+                }
+            });
+#else
+        _locator->ice_connectionId(observerConnectionId)->begin_ice_getConnection(
+            newCallback_Object_ice_getConnection(this, &LocatorInfo::addObserver, &LocatorInfo::addObserverException));
+#endif
+    }
+    catch(const Ice::Exception& ex)
+    {
+        addObserverException(ex);
+    }
+    return false;
+}
+
 void
 IceInternal::LocatorInfo::getEndpointsException(const ReferencePtr& ref, const Ice::Exception& exc)
 {
@@ -810,7 +1192,8 @@ void
 IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
                                         const vector<ReferencePtr>& wellKnownRefs,
                                         const Ice::ObjectPrxPtr& proxy,
-                                        bool notRegistered)
+                                        bool notRegistered,
+                                        Ice::Long changes)
 {
     if(!proxy || proxy->_getReference()->isIndirect())
     {
@@ -828,7 +1211,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
     {
         if(proxy && !proxy->_getReference()->isIndirect()) // Cache the adapter endpoints.
         {
-            _table->addAdapterEndpoints(ref->getAdapterId(), proxy->_getReference()->getEndpoints());
+            _table->addAdapterEndpoints(ref->getAdapterId(), proxy->_getReference()->getEndpoints(), changes);
         }
         else if(notRegistered) // If the adapter isn't registered anymore, remove it from the cache.
         {
@@ -843,7 +1226,7 @@ IceInternal::LocatorInfo::finishRequest(const ReferencePtr& ref,
     {
         if(proxy && !proxy->_getReference()->isWellKnown()) // Cache the well-known object reference.
         {
-            _table->addObjectReference(ref->getIdentity(), proxy->_getReference());
+            _table->addObjectReference(ref->getIdentity(), proxy->_getReference(), changes);
         }
         else if(notRegistered) // If the well-known object isn't registered anymore, remove it from the cache.
         {
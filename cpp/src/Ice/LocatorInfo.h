@@ -14,8 +14,11 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/LocatorInfoF.h>
 #include <Ice/LocatorF.h>
+#include <Ice/ConnectionF.h>
+#include <Ice/ObjectAdapterF.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/Identity.h>
 #include <Ice/EndpointIF.h>
@@ -44,6 +47,7 @@ public:
 private:
 
     const bool _background;
+    const bool _notifications;
 
 #ifdef ICE_CPP11_MAPPING
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
@@ -66,18 +70,29 @@ public:
 
     void clear();
 
+    //
+    // The add methods ignore the results obtained before the last
+    // change notified by the locator, the caller provides the value
+    // returned by getChanges() when it asked the locator.
+    //
     bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
-    void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
+    void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&, Ice::Long);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
 
     bool getObjectReference(const Ice::Identity&, int, ReferencePtr&);
-    void addObjectReference(const Ice::Identity&, const ReferencePtr&);
+    void addObjectReference(const Ice::Identity&, const ReferencePtr&, Ice::Long);
     ReferencePtr removeObjectReference(const Ice::Identity&);
 
+    void adapterChanged(const std::string&);
+    void objectChanged(const Ice::Identity&);
+    Ice::Long getChanges();
+
 private:
 
     bool checkTTL(const IceUtil::Time&, int) const;
 
+    Ice::Long _changes;
+
     std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
     std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
 };
@@ -129,6 +144,7 @@ public:
 
         const LocatorInfoPtr _locatorInfo;
         const ReferencePtr _ref;
+        const Ice::Long _changes;
 
     private:
 
@@ -142,7 +158,7 @@ public:
     };
     typedef IceUtil::Handle<Request> RequestPtr;
 
-    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool);
+    LocatorInfo(const Ice::LocatorPrxPtr&, const LocatorTablePtr&, bool, bool);
 
     void destroy();
 
@@ -166,8 +182,15 @@ public:
 
     void clearCache(const ReferencePtr&);
 
+    void addObserver(const Ice::ConnectionPtr&);
+    void addObserverResponse(const Ice::ConnectionPtr&);
+    void addObserverException(const Ice::Exception&);
+    void observerClosed(const Ice::ConnectionPtr&);
+
 private:
 
+    bool checkObserver();
+
     void getEndpointsException(const ReferencePtr&, const Ice::Exception&);
     void getEndpointsTrace(const ReferencePtr&, const std::vector<EndpointIPtr>&, bool);
     void trace(const std::string&, const ReferencePtr&, const std::vector<EndpointIPtr>&);
@@ -175,7 +198,8 @@ private:
     RequestPtr getAdapterRequest(const ReferencePtr&);
     RequestPtr getObjectRequest(const ReferencePtr&);
 
-    void finishRequest(const ReferencePtr&, const std::vector<ReferencePtr>&, const Ice::ObjectPrxPtr&, bool);
+    void finishRequest(const ReferencePtr&, const std::vector<ReferencePtr>&, const Ice::ObjectPrxPtr&, bool,
+                       Ice::Long);
     friend class Request;
     friend class RequestCallback;
 
@@ -184,6 +208,19 @@ private:
     const LocatorTablePtr _table;
     const bool _background;
 
+    //
+    // If notifications are enabled, a locator cache observer is added
+    // to the locator over a dedicated connection. The cached results
+    // don't expire while it's added.
+    //
+    const bool _notifications;
+    bool _notificationsUnsupported;
+    bool _addingObserver;
+    IceUtilInternal::Atomic _observerActive; // Checked without the mutex by getEndpoints.
+    Ice::ConnectionPtr _observerConnection; // The connection used to add the observer.
+    Ice::ObjectAdapterPtr _observerAdapter;
+    Ice::ObjectPrxPtr _observer;
+
     std::map<std::string, RequestPtr> _adapterRequests;
     std::map<Ice::Identity, RequestPtr> _objectRequests;
 };
@@ -123,6 +123,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheNotifications", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
@@ -648,6 +649,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.CollocateRegistry", false, 0),
     IceInternal::Property("IceGrid.Node.Data", false, 0),
     IceInternal::Property("IceGrid.Node.DisableOnFailure", false, 0),
+    IceInternal::Property("IceGrid.Node.DispatchMetricsView", false, 0),
     IceInternal::Property("IceGrid.Node.Name", false, 0),
     IceInternal::Property("IceGrid.Node.Output", false, 0),
     IceInternal::Property("IceGrid.Node.ProcessorSocketCount", false, 0),
@@ -852,6 +854,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.ObserverPageSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.ObserverQueueSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.ParallelInstantiationThreshold", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.ConnectionCached", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.PreferSecure", false, 0),
@@ -864,6 +869,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaName", false, 0),
     IceInternal::Property("IceGrid.Registry.ReplicaSessionTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.ReplicationLogSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.ReplicationLogSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireNodeCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.RequireReplicaCertCN", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ACM.Timeout", false, 0),
@@ -966,6 +973,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Trace.Topic", false, 0),
     IceInternal::Property("IceGrid.Registry.Trace.TopicManager", false, 0),
     IceInternal::Property("IceGrid.Registry.UserAccounts", false, 0),
+    IceInternal::Property("IceGrid.Registry.WarmPool.*", false, 0),
 };
 
 const IceInternal::PropertyArray
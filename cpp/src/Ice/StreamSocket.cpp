@@ -230,7 +230,7 @@ StreamSocket::write(Buffer& buf)
 
 #if !defined(ICE_OS_UWP)
 ssize_t
-StreamSocket::read(char* buf, size_t length)
+StreamSocket::read(char* buf, size_t length, bool untilWouldBlock)
 {
     assert(_fd != INVALID_SOCKET);
 
@@ -286,6 +286,11 @@ StreamSocket::read(char* buf, size_t length)
         read += ret;
         length -= ret;
 
+        if(!untilWouldBlock)
+        {
+            break;
+        }
+
         if(packetSize > length)
         {
             packetSize = length;
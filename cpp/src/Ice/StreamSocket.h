@@ -37,7 +37,7 @@ public:
     SocketOperation write(Buffer&);
 
 #if !defined(ICE_OS_UWP)
-    ssize_t read(char*, size_t);
+    ssize_t read(char*, size_t, bool = true);
     ssize_t write(const char*, size_t);
 #endif
 
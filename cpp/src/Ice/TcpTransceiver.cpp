@@ -18,6 +18,18 @@ using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+namespace
+{
+
+//
+// Reads smaller than this size are served from the read-ahead buffer.
+//
+const size_t readAheadSize = 4096;
+
+}
+#endif
+
 NativeInfoPtr
 IceInternal::TcpTransceiver::getNativeInfo()
 {
@@ -53,7 +65,57 @@ IceInternal::TcpTransceiver::write(Buffer& buf)
 SocketOperation
 IceInternal::TcpTransceiver::read(Buffer& buf)
 {
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
     return _stream->read(buf);
+#else
+    //
+    // Small reads, such as the reads of message headers, fill a read-ahead buffer with a
+    // single recv() call, up to readAheadSize. The header and the body of a small message,
+    // or several small messages, are then read with one recv() call instead of two calls
+    // per message. Reads done by the network proxy while the socket isn't connected yet go
+    // through StreamSocket::read(Buffer&), which handles the proxy handshake.
+    //
+    bool drained = false;
+    if(_readBuffer.i == _readBuffer.b.end() && static_cast<size_t>(buf.b.end() - buf.i) < readAheadSize &&
+       _stream->isConnected())
+    {
+        //
+        // The buffer capacity is kept between fills, resize() doesn't reallocate it.
+        //
+        _readBuffer.b.resize(readAheadSize);
+        ssize_t ret = _stream->read(reinterpret_cast<char*>(&*_readBuffer.b.begin()), readAheadSize, false);
+        drained = static_cast<size_t>(ret) < readAheadSize; // A short read, no more data is available.
+        if(ret > 0)
+        {
+            _readBuffer.b.resize(static_cast<size_t>(ret));
+            _readBuffer.i = _readBuffer.b.begin();
+        }
+        else
+        {
+            _readBuffer.i = _readBuffer.b.end();
+        }
+    }
+
+    if(_readBuffer.i != _readBuffer.b.end())
+    {
+        size_t sz = static_cast<size_t>(min(buf.b.end() - buf.i, _readBuffer.b.end() - _readBuffer.i));
+        copy(_readBuffer.i, _readBuffer.i + sz, buf.i);
+        buf.i += sz;
+        _readBuffer.i += sz;
+
+        //
+        // If there's still buffered data, mark the socket as ready for reading: the
+        // thread pool won't be notified by the selector for data that was already
+        // received.
+        //
+        _stream->ready(SocketOperationRead, _readBuffer.i != _readBuffer.b.end());
+        if(buf.i == buf.b.end())
+        {
+            return SocketOperationNone;
+        }
+    }
+    return drained ? SocketOperationRead : _stream->read(buf);
+#endif
 }
 
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
@@ -14,6 +14,7 @@
 #include <Ice/Transceiver.h>
 #include <Ice/Network.h>
 #include <Ice/StreamSocket.h>
+#include <Ice/Buffer.h>
 
 namespace IceInternal
 {
@@ -56,6 +57,9 @@ private:
 
     const ProtocolInstancePtr _instance;
     const StreamSocketPtr _stream;
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    Buffer _readBuffer;
+#endif
 };
 
 }
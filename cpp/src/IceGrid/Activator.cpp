@@ -27,6 +27,7 @@
 #ifndef _WIN32
 #   include <sys/wait.h>
 #   include <signal.h>
+#   include <poll.h>
 #   include <pwd.h> // for getpwuid
 #else
 #ifndef SIGKILL
@@ -41,6 +42,17 @@
 #   include <grp.h> // for initgroups
 #endif
 
+#if defined(__linux)
+#   include <sys/syscall.h> // for SYS_close_range
+#endif
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#   if __GLIBC_PREREQ(2, 34) // for posix_spawn_file_actions_addclosefrom_np
+#      define ICE_GRID_USE_POSIX_SPAWN
+#      include <spawn.h>
+#   endif
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -108,6 +120,159 @@ reportChildError(int err, int fd, const char* cannot, const char* name, const Tr
     _exit(EXIT_FAILURE);
 }
 
+//
+// Close all the file descriptors of the child process, except for the
+// standard descriptors and the given descriptors. Must be async-signal
+// safe.
+//
+void
+closeChildDescriptors(int fd1, int fd2)
+{
+#if defined(__linux) && defined(SYS_close_range)
+    //
+    // Close the descriptors with close_range (Linux >= 5.9) rather than
+    // calling close for each descriptor up to the descriptor limit.
+    //
+    int keep[] = { min(fd1, fd2), max(fd1, fd2) };
+    int first = 3;
+    bool closed = true;
+    for(int i = 0; i < 2 && closed; ++i)
+    {
+        if(keep[i] > first)
+        {
+            closed = syscall(SYS_close_range, first, keep[i] - 1, 0) == 0;
+        }
+        first = max(first, keep[i] + 1);
+    }
+    if(closed && syscall(SYS_close_range, first, ~0U, 0) == 0)
+    {
+        return;
+    }
+#endif
+
+    int maxFd = static_cast<int>(sysconf(_SC_OPEN_MAX));
+    for(int fd = 3; fd < maxFd; ++fd)
+    {
+        if(fd != fd1 && fd != fd2)
+        {
+            close(fd);
+        }
+    }
+}
+
+#ifdef ICE_GRID_USE_POSIX_SPAWN
+//
+// The server can be spawned with posix_spawn if it doesn't need to run
+// with other user or group ids than the node. The executable must also
+// be searched with the node PATH.
+//
+bool
+canSpawn(const string& path, uid_t uid, gid_t gid, const Ice::StringSeq& envs)
+{
+    if(getuid() == 0 || uid != getuid() || gid != getgid())
+    {
+        return false;
+    }
+
+    if(path.find('/') == string::npos)
+    {
+        for(Ice::StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+        {
+            if(p->compare(0, 5, "PATH=") == 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//
+// Spawn the server with posix_spawn. Unlike fork, it doesn't copy the
+// address space of the node, glibc creates the child process with vfork
+// semantics. The child process is setup like the forked child process
+// in Activator::activate.
+//
+pid_t
+spawnServer(const IceInternal::ArgVector& av, const Ice::StringSeq& envs, const string& pwd, int pipeFd)
+{
+    vector<string> environment;
+    for(char** e = environ; *e; ++e)
+    {
+        environment.push_back(*e);
+    }
+    for(Ice::StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+    {
+        string name = p->substr(0, p->find('=')) + '=';
+        vector<string>::iterator q = environment.begin();
+        while(q != environment.end())
+        {
+            if(q->compare(0, name.size(), name) == 0)
+            {
+                q = environment.erase(q);
+            }
+            else
+            {
+                ++q;
+            }
+        }
+        environment.push_back(*p);
+    }
+    IceInternal::ArgVector env(environment);
+
+    //
+    // Only keep the standard descriptors and the write side of the pipe
+    // used to detect the server termination.
+    //
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipeFd, 3);
+    posix_spawn_file_actions_addclosefrom_np(&actions, 4);
+    if(!pwd.empty())
+    {
+        posix_spawn_file_actions_addchdir_np(&actions, pwd.c_str());
+    }
+
+    //
+    // Assign a new process group and unblock the signals blocked by
+    // IceUtil::CtrlCHandler.
+    //
+    sigset_t sigs;
+    pthread_sigmask(SIG_BLOCK, 0, &sigs);
+    sigdelset(&sigs, SIGHUP);
+    sigdelset(&sigs, SIGINT);
+    sigdelset(&sigs, SIGTERM);
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, av.argv[0], &actions, &attr, av.argv, env.argv);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if(err != 0)
+    {
+        ostringstream os;
+        if(!pwd.empty() && !IceUtilInternal::directoryExists(pwd))
+        {
+            os << "cannot change working directory to `" << pwd << "'";
+        }
+        else
+        {
+            os << "cannot execute `" << av.argv[0] << "'";
+        }
+        os << ": " << strerror(err);
+        throw os.str();
+    }
+    return pid;
+}
+#endif
+
 #endif
 
 string
@@ -639,166 +804,180 @@ Activator::activate(const string& name,
         throw ex;
     }
 
-    int errorFds[2];
-    if(pipe(errorFds) != 0)
-    {
-        SyscallException ex(__FILE__, __LINE__);
-        ex.error = getSystemErrno();
-        throw ex;
-    }
-
-
     //
     // Convert to standard argc/argv.
     //
     IceInternal::ArgVector av(args);
-    IceInternal::ArgVector env(envs);
 
-    //
-    // Current directory
-    //
-    const char* pwdCStr = pwd.c_str();
-
-    pid_t pid = fork();
-    if(pid == -1)
+    pid_t pid;
+#ifdef ICE_GRID_USE_POSIX_SPAWN
+    if(canSpawn(path, uid, gid, envs))
     {
-        SyscallException ex(__FILE__, __LINE__);
-        ex.error = getSystemErrno();
-        throw ex;
+        try
+        {
+            pid = spawnServer(av, envs, pwd, fds[1]);
+        }
+        catch(...)
+        {
+            close(fds[0]);
+            close(fds[1]);
+            throw;
+        }
+        close(fds[1]);
     }
-
-    if(pid == 0) // Child process.
+    else
+#endif
     {
-        //
-        // Until exec, we can only use async-signal safe functions
-        //
+        int errorFds[2];
+        if(pipe(errorFds) != 0)
+        {
+            SyscallException ex(__FILE__, __LINE__);
+            ex.error = getSystemErrno();
+            throw ex;
+        }
 
-        //
-        // Unblock signals blocked by IceUtil::CtrlCHandler.
-        //
-        sigset_t sigs;
-        sigemptyset(&sigs);
-        sigaddset(&sigs, SIGHUP);
-        sigaddset(&sigs, SIGINT);
-        sigaddset(&sigs, SIGTERM);
-        sigprocmask(SIG_UNBLOCK, &sigs, 0);
+        IceInternal::ArgVector env(envs);
 
         //
-        // Change the uid/gid under which the process will run.
+        // Current directory
         //
-        if(setgid(gid) == -1)
+        const char* pwdCStr = pwd.c_str();
+
+        pid = fork();
+        if(pid == -1)
         {
-            ostringstream os;
-            os << gid;
-            reportChildError(getSystemErrno(), errorFds[1], "cannot set process group id", os.str().c_str(),
-                             _traceLevels);
+            SyscallException ex(__FILE__, __LINE__);
+            ex.error = getSystemErrno();
+            throw ex;
         }
 
-        errno = 0;
-        struct passwd* pw = getpwuid(uid);
-        if(!pw)
+        if(pid == 0) // Child process.
         {
-            if(errno)
+            //
+            // Until exec, we can only use async-signal safe functions
+            //
+
+            //
+            // Unblock signals blocked by IceUtil::CtrlCHandler.
+            //
+            sigset_t sigs;
+            sigemptyset(&sigs);
+            sigaddset(&sigs, SIGHUP);
+            sigaddset(&sigs, SIGINT);
+            sigaddset(&sigs, SIGTERM);
+            sigprocmask(SIG_UNBLOCK, &sigs, 0);
+
+            //
+            // Change the uid/gid under which the process will run.
+            //
+            if(setgid(gid) == -1)
             {
-                reportChildError(getSystemErrno(), errorFds[1], "cannot read the password database", "",
+                ostringstream os;
+                os << gid;
+                reportChildError(getSystemErrno(), errorFds[1], "cannot set process group id", os.str().c_str(),
                                  _traceLevels);
             }
-            else
+
+            errno = 0;
+            struct passwd* pw = getpwuid(uid);
+            if(!pw)
+            {
+                if(errno)
+                {
+                    reportChildError(getSystemErrno(), errorFds[1], "cannot read the password database", "",
+                                     _traceLevels);
+                }
+                else
+                {
+                    ostringstream os;
+                    os << uid;
+                    reportChildError(getSystemErrno(), errorFds[1], "unknown user uid"  , os.str().c_str(),
+                                     _traceLevels);
+                }
+            }
+
+            //
+            // Don't initialize supplementary groups if we are not running as root.
+            //
+            if(getuid() == 0 && initgroups(pw->pw_name, gid) == -1)
+            {
+                ostringstream os;
+                os << pw->pw_name;
+                reportChildError(getSystemErrno(), errorFds[1], "cannot initialize process supplementary group access list for user",
+                                 os.str().c_str(), _traceLevels);
+            }
+
+            if(setuid(uid) == -1)
             {
                 ostringstream os;
                 os << uid;
-                reportChildError(getSystemErrno(), errorFds[1], "unknown user uid"  , os.str().c_str(),
+                reportChildError(getSystemErrno(), errorFds[1], "cannot set process user id", os.str().c_str(),
                                  _traceLevels);
             }
-        }
 
-        //
-        // Don't initialize supplementary groups if we are not running as root.
-        //
-        if(getuid() == 0 && initgroups(pw->pw_name, gid) == -1)
-        {
-            ostringstream os;
-            os << pw->pw_name;
-            reportChildError(getSystemErrno(), errorFds[1], "cannot initialize process supplementary group access list for user",
-                             os.str().c_str(), _traceLevels);
-        }
+            //
+            // Assign a new process group for this process.
+            //
+            setpgid(0, 0);
 
-        if(setuid(uid) == -1)
-        {
-            ostringstream os;
-            os << uid;
-            reportChildError(getSystemErrno(), errorFds[1], "cannot set process user id", os.str().c_str(),
-                             _traceLevels);
-        }
+            //
+            // Close all file descriptors, except for standard input,
+            // standard output, standard error, and the write side
+            // of the newly created pipe.
+            //
+            closeChildDescriptors(fds[1], errorFds[1]);
 
-        //
-        // Assign a new process group for this process.
-        //
-        setpgid(0, 0);
+            for(int i = 0; i < env.argc; i++)
+            {
+                //
+                // Each env is leaked on purpose ... see man putenv().
+                //
+                if(putenv(strdup(env.argv[i])) != 0)
+                {
+                    reportChildError(errno, errorFds[1], "cannot set environment variable",  env.argv[i],
+                                     _traceLevels);
+                }
+            }
 
-        //
-        // Close all file descriptors, except for standard input,
-        // standard output, standard error, and the write side
-        // of the newly created pipe.
-        //
-        int maxFd = static_cast<int>(sysconf(_SC_OPEN_MAX));
-        for(int fd = 3; fd < maxFd; ++fd)
-        {
-            if(fd != fds[1] && fd != errorFds[1])
+            //
+            // Change working directory.
+            //
+            if(strlen(pwdCStr) != 0)
             {
-                close(fd);
+                if(chdir(pwdCStr) == -1)
+                {
+                    reportChildError(errno, errorFds[1], "cannot change working directory to",  pwdCStr,
+                                     _traceLevels);
+                }
             }
-        }
 
-        for(int i = 0; i < env.argc; i++)
-        {
             //
-            // Each env is leaked on purpose ... see man putenv().
+            // Close on exec the error message file descriptor.
             //
-            if(putenv(strdup(env.argv[i])) != 0)
+            int flags = fcntl(errorFds[1], F_GETFD);
+            flags |= 1; // FD_CLOEXEC
+            if(fcntl(errorFds[1], F_SETFD, flags) == -1)
             {
-                reportChildError(errno, errorFds[1], "cannot set environment variable",  env.argv[i],
-                                 _traceLevels);
+                close(errorFds[1]);
+                errorFds[1] = -1;
             }
-        }
 
-        //
-        // Change working directory.
-        //
-        if(strlen(pwdCStr) != 0)
-        {
-            if(chdir(pwdCStr) == -1)
+            if(execvp(av.argv[0], av.argv) == -1)
             {
-                reportChildError(errno, errorFds[1], "cannot change working directory to",  pwdCStr,
-                                 _traceLevels);
+                if(errorFds[1] != -1)
+                {
+                    reportChildError(errno, errorFds[1], "cannot execute",  av.argv[0], _traceLevels);
+                }
+                else
+                {
+                    reportChildError(errno, fds[1], "cannot execute",  av.argv[0], _traceLevels);
+                }
             }
         }
 
         //
-        // Close on exec the error message file descriptor.
+        // Parent process.
         //
-        int flags = fcntl(errorFds[1], F_GETFD);
-        flags |= 1; // FD_CLOEXEC
-        if(fcntl(errorFds[1], F_SETFD, flags) == -1)
-        {
-            close(errorFds[1]);
-            errorFds[1] = -1;
-        }
-
-        if(execvp(av.argv[0], av.argv) == -1)
-        {
-            if(errorFds[1] != -1)
-            {
-                reportChildError(errno, errorFds[1], "cannot execute",  av.argv[0], _traceLevels);
-            }
-            else
-            {
-                reportChildError(errno, fds[1], "cannot execute",  av.argv[0], _traceLevels);
-            }
-        }
-    }
-    else // Parent process.
-    {
         close(fds[1]);
         close(errorFds[1]);
 
@@ -829,29 +1008,29 @@ Activator::activate(const string& name,
         // pipe anymore.
         //
         close(errorFds[0]);
+    }
 
-        Process process;
-        process.pid = pid;
-        process.pipeFd = fds[0];
-        process.server = server;
-        _processes.insert(make_pair(name, process));
+    Process process;
+    process.pid = pid;
+    process.pipeFd = fds[0];
+    process.server = server;
+    _processes.insert(make_pair(name, process));
 
-        int flags = fcntl(process.pipeFd, F_GETFL);
-        flags |= O_NONBLOCK;
-        fcntl(process.pipeFd, F_SETFL, flags);
+    int flags = fcntl(process.pipeFd, F_GETFL);
+    flags |= O_NONBLOCK;
+    fcntl(process.pipeFd, F_SETFL, flags);
 
-        setInterrupt();
+    setInterrupt();
 
     //
     // Don't print the following trace, this might interfere with the
     // output of the started process if it fails with an error message.
     //
-//      if(_traceLevels->activator > 0)
-//      {
-//          Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
-//          out << "activated server `" << name << "' (pid = " << pid << ")";
-//      }
-    }
+//  if(_traceLevels->activator > 0)
+//  {
+//      Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
+//      out << "activated server `" << name << "' (pid = " << pid << ")";
+//  }
 
     return pid;
 #endif
@@ -1237,27 +1416,29 @@ Activator::terminationListener()
 #else
     while(true)
     {
-        fd_set fdSet;
-        int maxFd = _fdIntrRead;
-        FD_ZERO(&fdSet);
-        FD_SET(_fdIntrRead, &fdSet);
-
+        //
+        // Use poll rather than select, the pipe descriptors of the servers
+        // aren't limited to FD_SETSIZE.
+        //
+        vector<struct pollfd> pollFds;
         {
             IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
 
+            pollFds.reserve(_processes.size() + 1);
+            struct pollfd pfd;
+            pfd.fd = _fdIntrRead;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            pollFds.push_back(pfd);
             for(map<string, Process>::iterator p = _processes.begin(); p != _processes.end(); ++p)
             {
-                int fd = p->second.pipeFd;
-                FD_SET(fd, &fdSet);
-                if(maxFd < fd)
-                {
-                    maxFd = fd;
-                }
+                pfd.fd = p->second.pipeFd;
+                pollFds.push_back(pfd);
             }
         }
 
-    repeatSelect:
-        int ret = ::select(maxFd + 1, &fdSet, 0, 0, 0);
+    repeatPoll:
+        int ret = ::poll(&pollFds[0], static_cast<nfds_t>(pollFds.size()), -1);
         assert(ret != 0);
 
         if(ret == -1)
@@ -1265,12 +1446,12 @@ Activator::terminationListener()
 #ifdef EPROTO
             if(errno == EINTR || errno == EPROTO)
             {
-                goto repeatSelect;
+                goto repeatPoll;
             }
 #else
             if(errno == EINTR)
             {
-                goto repeatSelect;
+                goto repeatPoll;
             }
 #endif
 
@@ -1279,12 +1460,21 @@ Activator::terminationListener()
             throw ex;
         }
 
+        set<int> readyFds;
+        for(vector<struct pollfd>::const_iterator p = pollFds.begin(); p != pollFds.end(); ++p)
+        {
+            if(p->revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                readyFds.insert(p->fd);
+            }
+        }
+
         vector<Process> terminated;
         bool deactivated = false;
         {
             IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
 
-            if(FD_ISSET(_fdIntrRead, &fdSet))
+            if(readyFds.find(_fdIntrRead) != readyFds.end())
             {
                 clearInterrupt();
 
@@ -1298,7 +1488,7 @@ Activator::terminationListener()
             while(p != _processes.end())
             {
                 int fd = p->second.pipeFd;
-                if(!FD_ISSET(fd, &fdSet))
+                if(readyFds.find(fd) == readyFds.end())
                 {
                     ++p;
                     continue;
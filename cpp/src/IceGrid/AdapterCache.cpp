@@ -409,6 +409,24 @@ ServerAdapterEntry::getLeastLoadedNodeLoad(LoadSample loadSample) const
     return 999.9f;
 }
 
+float
+ServerAdapterEntry::getDispatchLoad() const
+{
+    try
+    {
+        return _server->getDispatchLoad();
+    }
+    catch(const ServerNotExistException&)
+    {
+        // This might happen if the application is updated concurrently.
+    }
+    catch(const NodeNotExistException&)
+    {
+        // This might happen if the application is updated concurrently.
+    }
+    return -1.0f;
+}
+
 AdapterInfoSeq
 ServerAdapterEntry::getAdapterInfo() const
 {
@@ -468,6 +486,12 @@ ServerAdapterEntry::getServerId() const
     return _server->getId();
 }
 
+bool
+ServerAdapterEntry::isServerEnabled() const
+{
+    return _server->isEnabled();
+}
+
 string
 ServerAdapterEntry::getNodeName() const
 {
@@ -487,6 +511,7 @@ ReplicaGroupEntry::ReplicaGroupEntry(AdapterCache& cache,
                                      const LoadBalancingPolicyPtr& policy, 
                                      const string& filter) : 
     AdapterEntry(cache, id, application),
+    _dispatchLoad(false),
     _lastReplica(0),
     _requestInProgress(false)
 {
@@ -585,10 +610,16 @@ ReplicaGroupEntry::update(const string& application, const LoadBalancingPolicyPt
     int nReplicas = 0;
     is >> nReplicas;
     _loadBalancingNReplicas = nReplicas < 0 ? 1 : nReplicas;
+    _dispatchLoad = false;
     AdaptiveLoadBalancingPolicyPtr alb = AdaptiveLoadBalancingPolicyPtr::dynamicCast(_loadBalancing);
     if(alb)
     {
-        if(alb->loadSample == "1")
+        if(alb->loadSample == "dispatch")
+        {
+            _loadSample = LoadSample1;
+            _dispatchLoad = true;
+        }
+        else if(alb->loadSample == "1")
         {
             _loadSample = LoadSample1;
         }
@@ -613,6 +644,7 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
 {
     vector<ServerAdapterEntryPtr> replicas;
     bool adaptive = false;
+    bool dispatchLoad = false;
     LoadSample loadSample = LoadSample1;
     {
         Lock sync(*this);
@@ -648,7 +680,8 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             RandomNumberGenerator rng;
             random_shuffle(replicas.begin(), replicas.end(), rng);
             loadSample = _loadSample;
-            adaptive = true;
+            dispatchLoad = _dispatchLoad;
+            adaptive = !dispatchLoad;
         }
         else if(OrderedLoadBalancingPolicyPtr::dynamicCast(_loadBalancing))
         {
@@ -682,6 +715,24 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             replicas.clear();
             transform(rl.begin(), rl.end(), back_inserter(replicas), TransformToReplica());
         }
+        else if(dispatchLoad && replicas.size() > 1)
+        {
+            //
+            // Pick the least loaded of two random replicas (power of two
+            // choices) using the dispatch load of the servers, the other
+            // replicas are kept in random order. This doesn't require the
+            // load of all the replicas and avoids sending all the clients
+            // to the same replica between two load updates. A replica
+            // whose load is unknown is only picked if the load of the
+            // other replica is also unknown.
+            //
+            float load0 = replicas[0]->getDispatchLoad();
+            float load1 = replicas[1]->getDispatchLoad();
+            if(load1 >= 0.0f && (load0 < 0.0f || load1 < load0))
+            {
+                swap(replicas[0], replicas[1]);
+            }
+        }
 
         //
         // Retrieve the proxy of each adapter from the server. The adapter
@@ -812,3 +863,10 @@ ReplicaGroupEntry::hasAdaptersFromOtherApplications() const
     }
     return false;
 }
+
+vector<ServerAdapterEntryPtr>
+ReplicaGroupEntry::getReplicas() const
+{
+    Lock sync(*this);
+    return _replicas;
+}
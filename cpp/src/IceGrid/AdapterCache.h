@@ -86,11 +86,13 @@ public:
     virtual AdapterPrx getProxy(const std::string&, bool) const;
 
     void getLocatorAdapterInfo(LocatorAdapterInfoSeq&) const;
+    float getDispatchLoad() const;
     const std::string& getReplicaGroupId() const { return _replicaGroupId; }
     int getPriority() const;
 
     std::string getServerId() const;
     std::string getNodeName() const;
+    bool isServerEnabled() const;
 
 private:
 
@@ -120,6 +122,7 @@ public:
 
     void update(const std::string&, const LoadBalancingPolicyPtr&, const std::string&);
     bool hasAdaptersFromOtherApplications() const;
+    std::vector<ServerAdapterEntryPtr> getReplicas() const;
 
     const std::string& getFilter() const { return _filter; }
 
@@ -128,6 +131,7 @@ private:
     LoadBalancingPolicyPtr _loadBalancing;
     int _loadBalancingNReplicas;
     LoadSample _loadSample;
+    bool _dispatchLoad;
     std::string _filter;
     std::vector<ServerAdapterEntryPtr> _replicas;
     int _lastReplica;
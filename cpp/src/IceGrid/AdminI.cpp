@@ -458,6 +458,11 @@ AdminI::startServer_async(const AMD_Admin_startServerPtr& amdCB, const string& i
     ServerProxyWrapper proxy(_database, id);
     proxy.useActivationTimeout();
 
+    if(_database->getWarmPool())
+    {
+        _database->getWarmPool()->serverStarted(id);
+    }
+
     //
     // Since the server might take a while to be activated, we use AMI.
     //
@@ -515,6 +520,14 @@ AdminI::stopServer_async(const AMD_Admin_stopServerPtr& amdCB, const string& id,
     ServerProxyWrapper proxy(_database, id);
     proxy.useDeactivationTimeout();
 
+    //
+    // The warm pool must not activate the server again once it's stopped.
+    //
+    if(_database->getWarmPool())
+    {
+        _database->getWarmPool()->serverStopped(id);
+    }
+
     //
     // Since the server might take a while to be deactivated, we use AMI.
     //
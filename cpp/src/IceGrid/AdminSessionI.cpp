@@ -22,6 +22,46 @@ using namespace IceGrid;
 namespace
 {
 
+//
+// Admin clients can provide the database serial of the last update
+// they received for the applications, adapters or objects with the
+// dbSerial.<database> context of the setObservers call. The observer
+// then only receives the updates it missed instead of the full state
+// if the registry still logs these updates.
+//
+Ice::Long
+getDatabaseSerial(const Ice::Context& context, TopicName name)
+{
+    string key;
+    switch(name)
+    {
+    case ApplicationObserverTopicName:
+        key = "dbSerial.applications";
+        break;
+    case AdapterObserverTopicName:
+        key = "dbSerial.adapters";
+        break;
+    case ObjectObserverTopicName:
+        key = "dbSerial.objects";
+        break;
+    default:
+        return -1;
+    }
+
+    Ice::Context::const_iterator p = context.find(key);
+    if(p == context.end())
+    {
+        return -1;
+    }
+
+    istringstream is(p->second);
+    Ice::Long serial;
+    if(!(is >> serial) || serial < 0)
+    {
+        return -1;
+    }
+    return serial;
+}
 
 class SubscriberForwarderI : public Ice::BlobjectArrayAsync
 {
@@ -204,7 +244,9 @@ AdminSessionI::setObservers(const RegistryObserverPrx& registryObserver,
     if(appObserver)
     {
         setupObserverSubscription(ApplicationObserverTopicName,
-                                  addForwarder(appObserver->ice_timeout(t)->ice_locator(l)));
+                                  addForwarder(appObserver->ice_timeout(t)->ice_locator(l)),
+                                  false,
+                                  getDatabaseSerial(current.ctx, ApplicationObserverTopicName));
     }
     else
     {
@@ -214,7 +256,9 @@ AdminSessionI::setObservers(const RegistryObserverPrx& registryObserver,
     if(adapterObserver)
     {
         setupObserverSubscription(AdapterObserverTopicName,
-                                  addForwarder(adapterObserver->ice_timeout(t)->ice_locator(l)));
+                                  addForwarder(adapterObserver->ice_timeout(t)->ice_locator(l)),
+                                  false,
+                                  getDatabaseSerial(current.ctx, AdapterObserverTopicName));
     }
     else
     {
@@ -224,7 +268,9 @@ AdminSessionI::setObservers(const RegistryObserverPrx& registryObserver,
     if(objectObserver)
     {
         setupObserverSubscription(ObjectObserverTopicName,
-                                  addForwarder(objectObserver->ice_timeout(t)->ice_locator(l)));
+                                  addForwarder(objectObserver->ice_timeout(t)->ice_locator(l)),
+                                  false,
+                                  getDatabaseSerial(current.ctx, ObjectObserverTopicName));
     }
     else
     {
@@ -250,9 +296,12 @@ AdminSessionI::setObserversByIdentity(const Ice::Identity& registryObserver,
 
     setupObserverSubscription(RegistryObserverTopicName, addForwarder(registryObserver, current), true);
     setupObserverSubscription(NodeObserverTopicName, addForwarder(nodeObserver, current), true);
-    setupObserverSubscription(ApplicationObserverTopicName, addForwarder(appObserver, current), true);
-    setupObserverSubscription(AdapterObserverTopicName, addForwarder(adapterObserver, current), true);
-    setupObserverSubscription(ObjectObserverTopicName, addForwarder(objectObserver, current), true);
+    setupObserverSubscription(ApplicationObserverTopicName, addForwarder(appObserver, current), true,
+                              getDatabaseSerial(current.ctx, ApplicationObserverTopicName));
+    setupObserverSubscription(AdapterObserverTopicName, addForwarder(adapterObserver, current), true,
+                              getDatabaseSerial(current.ctx, AdapterObserverTopicName));
+    setupObserverSubscription(ObjectObserverTopicName, addForwarder(objectObserver, current), true,
+                              getDatabaseSerial(current.ctx, ObjectObserverTopicName));
 }
 
 int
@@ -381,7 +430,8 @@ AdminSessionI::destroy(const Ice::Current&)
 }
 
 void
-AdminSessionI::setupObserverSubscription(TopicName name, const Ice::ObjectPrx& observer, bool forwarder)
+AdminSessionI::setupObserverSubscription(TopicName name, const Ice::ObjectPrx& observer, bool forwarder,
+                                         Ice::Long dbSerial)
 {
     if(_observers.find(name) != _observers.end() && _observers[name].first != observer)
     {
@@ -404,7 +454,7 @@ AdminSessionI::setupObserverSubscription(TopicName name, const Ice::ObjectPrx& o
     {
         _observers[name].first = observer;
         _observers[name].second = forwarder;
-        _database->getObserverTopic(name)->subscribe(observer);
+        _database->getObserverTopic(name)->subscribe(observer, string(), dbSerial);
     }
 }
 
@@ -65,7 +65,7 @@ public:
 
 private:
 
-    void setupObserverSubscription(TopicName, const Ice::ObjectPrx&, bool = false);
+    void setupObserverSubscription(TopicName, const Ice::ObjectPrx&, bool = false, Ice::Long = -1);
     Ice::ObjectPrx addForwarder(const Ice::Identity&, const Ice::Current&);
     Ice::ObjectPrx addForwarder(const Ice::ObjectPrx&);
     FileIteratorPrx addFileIterator(const FileReaderPrx&, const std::string&, int, const Ice::Current&);
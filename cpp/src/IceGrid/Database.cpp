@@ -86,6 +86,39 @@ toMap(const IceDB::Txn& txn, const IceDB::Dbi<K, V, C, H>& d)
     return m;
 }
 
+void
+notifyApplicationChanged(const LocatorCacheNotifierIPtr& notifier, const ApplicationHelper& app)
+{
+    if(!notifier->hasObservers())
+    {
+        return;
+    }
+
+    set<string> serverIds;
+    set<string> adapterIds;
+    set<Ice::Identity> objectIds;
+    app.getIds(serverIds, adapterIds, objectIds);
+    for(set<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+    {
+        notifier->adapterChanged(*p);
+    }
+    for(set<Ice::Identity>::const_iterator p = objectIds.begin(); p != objectIds.end(); ++p)
+    {
+        notifier->objectChanged(*p);
+    }
+}
+
+template<typename K, typename V> void
+resetProxies(const map<K, V>& infos, SnapshotMap<K, Ice::ObjectPrx>& proxies)
+{
+    map<K, Ice::ObjectPrx> m;
+    for(typename map<K, V>::const_iterator p = infos.begin(); p != infos.end(); ++p)
+    {
+        m.insert(make_pair(p->first, p->second.proxy));
+    }
+    proxies.reset(m);
+}
+
 void
 logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
 {
@@ -196,6 +229,7 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
                    const IceStorm::TopicManagerPrx& topicManager,
                    const string& instanceName,
                    const TraceLevelsPtr& traceLevels,
+                   const ReapThreadPtr& reaper,
                    const RegistryInfo& info,
                    bool readonly) :
     _communicator(registryAdapter->getCommunicator()),
@@ -211,11 +245,14 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _objectCache(_communicator),
     _allocatableObjectCache(_communicator),
     _serverCache(_communicator, _instanceName, _nodeCache, _adapterCache, _objectCache, _allocatableObjectCache),
+    _locatorCacheNotifier(new LocatorCacheNotifierI(_adapterCache, reaper, traceLevels)),
+    _warmPool(_master ? new WarmPool(_communicator, _adapterCache, traceLevels) : 0),
     _dbLock(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path") + "/icedb.lock"),
     _env(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path"), 8,
          IceDB::getMapSize(_communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.LMDB.MapSize"))),
     _pluginFacade(RegistryPluginFacadeIPtr::dynamicCast(getRegistryPluginFacade())),
-    _lock(0)
+    _lock(0),
+    _committingAdapterUpdates(false)
 {
     IceDB::ReadWriteTxn txn(_env);
 
@@ -262,7 +299,7 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _objectCache.setTraceLevels(_traceLevels);
     _allocatableObjectCache.setTraceLevels(_traceLevels);
 
-    _nodeObserverTopic = new NodeObserverTopic(_topicManager, _internalAdapter);
+    _nodeObserverTopic = new NodeObserverTopic(_topicManager, _internalAdapter, _locatorCacheNotifier, _warmPool);
     _registryObserverTopic = new RegistryObserverTopic(_topicManager);
 
     _serverCache.setNodeObserverTopic(_nodeObserverTopic);
@@ -289,6 +326,9 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _objectObserverTopic =
         new ObjectObserverTopic(_topicManager, toMap(txn, _objects), getSerial(txn, objectsDbName));
 
+    resetProxies(toMap(txn, _adapters), _adapterProxies);
+    resetProxies(toMap(txn, _objects), _objectProxies);
+
     txn.commit();
 
     _registryObserverTopic->registryUp(info);
@@ -414,7 +454,7 @@ Database::syncApplications(const ApplicationInfoSeq& newApplications, Ice::Long
                 if(q != oldApplications.end())
                 {
                     ApplicationHelper previous(_communicator, q->second.descriptor);
-                    ApplicationHelper helper(_communicator, p->descriptor);
+                    ApplicationHelper helper(_communicator, p->descriptor, false, true, &previous);
                     reload(previous, helper, entries, p->uuid, p->revision, false);
                 }
                 else
@@ -458,10 +498,12 @@ Database::syncAdapters(const AdapterInfoSeq& adapters, Ice::Long dbSerial)
     int serial = 0;
     {
         Lock sync(*this);
+        map<string, AdapterInfo> oldAdapters;
         try
         {
             IceDB::ReadWriteTxn txn(_env);
 
+            oldAdapters = toMap(txn, _adapters);
             _adapters.clear(txn);
             _adaptersByGroupId.clear(txn);
             for(AdapterInfoSeq::const_iterator r = adapters.begin(); r != adapters.end(); ++r)
@@ -482,6 +524,25 @@ Database::syncAdapters(const AdapterInfoSeq& adapters, Ice::Long dbSerial)
             throw;
         }
 
+        map<string, Ice::ObjectPrx> proxies;
+        for(AdapterInfoSeq::const_iterator r = adapters.begin(); r != adapters.end(); ++r)
+        {
+            proxies.insert(make_pair(r->id, r->proxy));
+        }
+        _adapterProxies.reset(proxies);
+
+        for(map<string, AdapterInfo>::const_iterator p = oldAdapters.begin(); p != oldAdapters.end(); ++p)
+        {
+            _locatorCacheNotifier->adapterChanged(p->first, p->second.replicaGroupId);
+        }
+        for(AdapterInfoSeq::const_iterator r = adapters.begin(); r != adapters.end(); ++r)
+        {
+            if(oldAdapters.find(r->id) == oldAdapters.end())
+            {
+                _locatorCacheNotifier->adapterChanged(r->id, r->replicaGroupId);
+            }
+        }
+
         if(_traceLevels->adapter > 0)
         {
             Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
@@ -500,10 +561,12 @@ Database::syncObjects(const ObjectInfoSeq& objects, Ice::Long dbSerial)
     int serial = 0;
     {
         Lock sync(*this);
+        map<Ice::Identity, ObjectInfo> oldObjects;
         try
         {
             IceDB::ReadWriteTxn txn(_env);
 
+            oldObjects = toMap(txn, _objects);
             _objects.clear(txn);
             _objectsByType.clear(txn);
             for(ObjectInfoSeq::const_iterator q = objects.begin(); q != objects.end(); ++q)
@@ -520,6 +583,25 @@ Database::syncObjects(const ObjectInfoSeq& objects, Ice::Long dbSerial)
             throw;
         }
 
+        map<Ice::Identity, Ice::ObjectPrx> proxies;
+        for(ObjectInfoSeq::const_iterator q = objects.begin(); q != objects.end(); ++q)
+        {
+            proxies.insert(make_pair(q->proxy->ice_getIdentity(), q->proxy));
+        }
+        _objectProxies.reset(proxies);
+
+        for(map<Ice::Identity, ObjectInfo>::const_iterator p = oldObjects.begin(); p != oldObjects.end(); ++p)
+        {
+            _locatorCacheNotifier->objectChanged(p->first);
+        }
+        for(map<Ice::Identity, Ice::ObjectPrx>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            if(oldObjects.find(p->first) == oldObjects.end())
+            {
+                _locatorCacheNotifier->objectChanged(p->first);
+            }
+        }
+
         if(_traceLevels->object > 0)
         {
             Ice::Trace out(_traceLevels->logger, _traceLevels->objectCat);
@@ -737,7 +819,8 @@ Database::updateApplication(const ApplicationUpdateInfo& updt, bool noRestart, A
         }
 
         previous.reset(new ApplicationHelper(_communicator, oldApp.descriptor));
-        helper.reset(new ApplicationHelper(_communicator, previous->update(update.descriptor), true));
+        helper.reset(new ApplicationHelper(_communicator, previous->update(update.descriptor), true, true,
+                                           previous.get()));
 
         startUpdating(update.descriptor.name, oldApp.uuid, oldApp.revision + 1);
     }
@@ -774,7 +857,7 @@ Database::syncApplicationDescriptor(const ApplicationDescriptor& newDesc, bool n
         }
 
         previous.reset(new ApplicationHelper(_communicator, oldApp.descriptor));
-        helper.reset(new ApplicationHelper(_communicator, newDesc, true));
+        helper.reset(new ApplicationHelper(_communicator, newDesc, true, true, previous.get()));
 
         update.updateTime = IceUtil::Time::now().toMilliSeconds();
         update.updateUser = _lockUserId;
@@ -820,7 +903,8 @@ Database::instantiateServer(const string& application,
         }
 
         previous.reset(new ApplicationHelper(_communicator, oldApp.descriptor));
-        helper.reset(new ApplicationHelper(_communicator, previous->instantiateServer(node, instance), true));
+        helper.reset(new ApplicationHelper(_communicator, previous->instantiateServer(node, instance), true, true,
+                                           previous.get()));
 
         update.updateTime = IceUtil::Time::now().toMilliSeconds();
         update.updateUser = _lockUserId;
@@ -999,86 +1083,258 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
 {
     assert(dbSerial != 0 || _master);
 
-    int serial = 0; // Initialize to prevent warning.
+    AdapterUpdatePtr update = new AdapterUpdate;
+    update->info.id = adapterId;
+    update->info.proxy = proxy;
+    update->info.replicaGroupId = replicaGroupId;
+    update->dbSerial = dbSerial;
+    update->found = false;
+    update->committedSerial = 0;
+    update->serial = 0;
+    update->done = false;
+
     {
-        Lock sync(*this);
-        if(_adapterCache.has(adapterId))
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_adapterUpdatesMonitor);
+        _adapterUpdates.push_back(update);
+        while(!update->done)
         {
-            throw AdapterExistsException(adapterId);
+            if(_committingAdapterUpdates)
+            {
+                _adapterUpdatesMonitor.wait();
+                continue;
+            }
+
+            //
+            // Commit our update with the updates queued while the
+            // previous commit was in progress.
+            //
+            vector<AdapterUpdatePtr> updates;
+            updates.swap(_adapterUpdates);
+            _committingAdapterUpdates = true;
+
+            _adapterUpdatesMonitor.unlock();
+            try
+            {
+                commitAdapterUpdates(updates);
+            }
+            catch(const IceUtil::Exception& ex)
+            {
+                for(vector<AdapterUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+                {
+                    if(!(*p)->exception.get())
+                    {
+                        (*p)->exception.reset(ex.ice_clone());
+                    }
+                }
+            }
+            catch(...)
+            {
+                //
+                // Don't leave the queued updates waiting for the commit,
+                // they fail with an unknown exception and the exception
+                // is raised to our caller.
+                //
+                _adapterUpdatesMonitor.lock();
+                for(vector<AdapterUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+                {
+                    if(p->get() != update.get() && !(*p)->exception.get())
+                    {
+                        (*p)->exception.reset(new Ice::UnknownException(__FILE__, __LINE__,
+                                                                        "adapter update commit failed"));
+                    }
+                    (*p)->done = true;
+                }
+                _committingAdapterUpdates = false;
+                _adapterUpdatesMonitor.notifyAll();
+                throw;
+            }
+            _adapterUpdatesMonitor.lock();
+
+            for(vector<AdapterUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+            {
+                (*p)->done = true;
+            }
+            _committingAdapterUpdates = false;
+            _adapterUpdatesMonitor.notifyAll();
         }
+    }
 
-        AdapterInfo info;
-        info.id = adapterId;
-        info.proxy = proxy;
-        info.replicaGroupId = replicaGroupId;
+    if(update->exception.get())
+    {
+        update->exception->ice_throw();
+    }
+    _adapterObserverTopic->waitForSyncedSubscribers(update->serial);
+}
+
+void
+Database::commitAdapterUpdates(const vector<AdapterUpdatePtr>& updates)
+{
+    Lock sync(*this);
+
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+    vector<AdapterUpdatePtr> pending;
+    for(vector<AdapterUpdatePtr>::const_iterator p = updates.begin(); p != updates.end(); ++p)
+    {
+        if(_adapterCache.has((*p)->info.id))
+        {
+            (*p)->exception.reset(new AdapterExistsException((*p)->info.id));
+        }
+        else
+        {
+            pending.push_back(*p);
+        }
+    }
 
-        bool updated = false;
+    vector<AdapterUpdatePtr> committed;
+    while(!pending.empty())
+    {
         try
         {
             IceDB::ReadWriteTxn txn(_env);
 
-            AdapterInfo oldInfo;
-            bool found = _adapters.get(txn, adapterId, oldInfo);
-            if(proxy)
+            committed.clear();
+            for(vector<AdapterUpdatePtr>::iterator p = pending.begin(); p != pending.end(); ++p)
             {
-                updated = found;
-
-                if(replicaGroupId != oldInfo.replicaGroupId)
+                try
                 {
-                    _adaptersByGroupId.del(txn, oldInfo.replicaGroupId, adapterId);
+                    if(applyAdapterUpdate(txn, *p))
+                    {
+                        committed.push_back(*p);
+                    }
                 }
-                addAdapter(txn, info);
-            }
-            else
-            {
-                if(!found)
+                catch(const IceDB::KeyTooLongException& ex)
                 {
-                    return;
+                    //
+                    // The transaction is aborted and the other updates
+                    // are committed with a new transaction.
+                    //
+                    (*p)->exception.reset(ex.ice_clone());
+                    pending.erase(p);
+                    throw;
                 }
-                deleteAdapter(txn, oldInfo);
             }
-            dbSerial = updateSerial(txn, adaptersDbName, dbSerial);
 
             txn.commit();
+            break;
         }
         catch(const IceDB::KeyTooLongException&)
         {
-            throw;
+            committed.clear();
         }
         catch(const IceDB::LMDBException& ex)
         {
             logError(_communicator, ex);
-            throw;
+            for(vector<AdapterUpdatePtr>::const_iterator p = pending.begin(); p != pending.end(); ++p)
+            {
+                (*p)->exception.reset(ex.ice_clone());
+            }
+            committed.clear();
+            break;
+        }
+    }
+
+    if(committed.empty())
+    {
+        return;
+    }
+
+    if(_traceLevels->adapter > 1)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
+        out << "committed " << committed.size() << " adapter update(s) in "
+            << (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMilliSecondsDouble() << "ms";
+    }
+
+    //
+    // Publish the proxies of the batch with a single snapshot of the
+    // adapter proxies.
+    //
+    map<string, Ice::ObjectPrx> proxies = _adapterProxies.copy();
+    for(vector<AdapterUpdatePtr>::const_iterator p = committed.begin(); p != committed.end(); ++p)
+    {
+        if((*p)->info.proxy)
+        {
+            proxies[(*p)->info.id] = (*p)->info.proxy;
+        }
+        else
+        {
+            proxies.erase((*p)->info.id);
+        }
+    }
+    _adapterProxies.reset(proxies);
+
+    for(vector<AdapterUpdatePtr>::const_iterator p = committed.begin(); p != committed.end(); ++p)
+    {
+        const AdapterInfo& info = (*p)->info;
+        const AdapterInfo& oldInfo = (*p)->oldInfo;
+
+        _locatorCacheNotifier->adapterChanged(info.id, info.replicaGroupId);
+        if(!oldInfo.replicaGroupId.empty() && oldInfo.replicaGroupId != info.replicaGroupId)
+        {
+            _locatorCacheNotifier->adapterChanged(oldInfo.replicaGroupId);
         }
 
+        bool updated = info.proxy && (*p)->found;
         if(_traceLevels->adapter > 0)
         {
             Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
-            out << (proxy ? (updated ? "updated" : "added") : "removed") << " adapter `" << adapterId << "'";
-            if(!replicaGroupId.empty())
+            out << (info.proxy ? (updated ? "updated" : "added") : "removed") << " adapter `" << info.id << "'";
+            if(!info.replicaGroupId.empty())
             {
-                out << " with replica group `" << replicaGroupId << "'";
+                out << " with replica group `" << info.replicaGroupId << "'";
             }
-            out << " (serial = `" << dbSerial << "')";
+            out << " (serial = `" << (*p)->committedSerial << "')";
         }
 
-        if(proxy)
+        if(info.proxy)
         {
             if(updated)
             {
-                serial = _adapterObserverTopic->adapterUpdated(dbSerial, info);
+                (*p)->serial = _adapterObserverTopic->adapterUpdated((*p)->committedSerial, info);
             }
             else
             {
-                serial = _adapterObserverTopic->adapterAdded(dbSerial, info);
+                (*p)->serial = _adapterObserverTopic->adapterAdded((*p)->committedSerial, info);
             }
         }
         else
         {
-            serial = _adapterObserverTopic->adapterRemoved(dbSerial, adapterId);
+            (*p)->serial = _adapterObserverTopic->adapterRemoved((*p)->committedSerial, info.id);
         }
     }
-    _adapterObserverTopic->waitForSyncedSubscribers(serial);
+}
+
+bool
+Database::applyAdapterUpdate(const IceDB::ReadWriteTxn& txn, const AdapterUpdatePtr& update)
+{
+    const AdapterInfo& info = update->info;
+    update->oldInfo = AdapterInfo();
+    update->found = _adapters.get(txn, info.id, update->oldInfo);
+    if(info.proxy)
+    {
+        if(info.replicaGroupId != update->oldInfo.replicaGroupId)
+        {
+            _adaptersByGroupId.del(txn, update->oldInfo.replicaGroupId, info.id);
+        }
+        addAdapter(txn, info);
+    }
+    else
+    {
+        if(!update->found)
+        {
+            return false;
+        }
+        deleteAdapter(txn, update->oldInfo);
+    }
+    update->committedSerial = updateSerial(txn, adaptersDbName, update->dbSerial);
+    return true;
+}
+
+Ice::ObjectPrx
+Database::getRegisteredAdapterProxy(const string& id) const
+{
+    return _adapterProxies.get(id);
 }
 
 Ice::ObjectPrx
@@ -1130,12 +1386,12 @@ Database::removeAdapter(const string& adapterId)
         }
 
         AdapterInfoSeq infos;
+        AdapterInfo info;
         Ice::Long dbSerial = 0;
         try
         {
             IceDB::ReadWriteTxn txn(_env);
 
-            AdapterInfo info;
             if(_adapters.get(txn, adapterId, info))
             {
                 deleteAdapter(txn, info);
@@ -1168,6 +1424,12 @@ Database::removeAdapter(const string& adapterId)
             throw;
         }
 
+        if(infos.empty())
+        {
+            _adapterProxies.remove(adapterId);
+        }
+        _locatorCacheNotifier->adapterChanged(adapterId, info.replicaGroupId);
+
         if(_traceLevels->adapter > 0)
         {
             Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
@@ -1480,6 +1742,9 @@ Database::addObject(const ObjectInfo& info)
             throw;
         }
 
+        _objectProxies.put(id, info.proxy);
+        _locatorCacheNotifier->objectChanged(id);
+
         serial = _objectObserverTopic->objectAdded(dbSerial, info);
 
         if(_traceLevels->object > 0)
@@ -1529,6 +1794,9 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
             throw;
         }
 
+        _objectProxies.put(id, info.proxy);
+        _locatorCacheNotifier->objectChanged(id);
+
         if(update)
         {
             serial = _objectObserverTopic->objectUpdated(dbSerial, info);
@@ -1587,6 +1855,9 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
             throw;
         }
 
+        _objectProxies.remove(id);
+        _locatorCacheNotifier->objectChanged(id);
+
         serial = _objectObserverTopic->objectRemoved(dbSerial, id);
 
         if(_traceLevels->object > 0)
@@ -1642,6 +1913,9 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
             throw;
         }
 
+        _objectProxies.put(id, proxy);
+        _locatorCacheNotifier->objectChanged(id);
+
         serial = _objectObserverTopic->objectUpdated(dbSerial, info);
         if(_traceLevels->object > 0)
         {
@@ -1677,6 +1951,12 @@ Database::addOrUpdateRegistryWellKnownObjects(const ObjectInfoSeq& objects)
         throw;
     }
 
+    for(ObjectInfoSeq::const_iterator p = objects.begin(); p != objects.end(); ++p)
+    {
+        _objectProxies.put(p->proxy->ice_getIdentity(), p->proxy);
+        _locatorCacheNotifier->objectChanged(p->proxy->ice_getIdentity());
+    }
+
     return _objectObserverTopic->wellKnownObjectsAddedOrUpdated(objects);
 }
 
@@ -1704,32 +1984,35 @@ Database::removeRegistryWellKnownObjects(const ObjectInfoSeq& objects)
         throw;
     }
 
+    for(ObjectInfoSeq::const_iterator p = objects.begin(); p != objects.end(); ++p)
+    {
+        _objectProxies.remove(p->proxy->ice_getIdentity());
+        _locatorCacheNotifier->objectChanged(p->proxy->ice_getIdentity());
+    }
+
     return _objectObserverTopic->wellKnownObjectsRemoved(objects);
 }
 
 Ice::ObjectPrx
 Database::getObjectProxy(const Ice::Identity& id)
 {
-    try
-    {
-        //
-        // Only return proxies for non allocatable objects.
-        //
-        return _objectCache.get(id)->getProxy();
-    }
-    catch(const ObjectNotRegisteredException&)
+    //
+    // Only return proxies for non allocatable objects. The proxies are
+    // read from snapshots, this doesn't lock the database or the cache.
+    //
+    Ice::ObjectPrx proxy = _objectCache.getProxy(id);
+    if(proxy)
     {
+        return proxy;
     }
-
-    IceDB::ReadOnlyTxn txn(_env);
-    ObjectInfo info;
-    if(!_objects.get(txn, id, info))
+    proxy = _objectProxies.get(id);
+    if(!proxy)
     {
         ObjectNotRegisteredException ex;
         ex.id = id;
         throw ex;
     }
-    return info.proxy;
+    return proxy;
 }
 
 Ice::ObjectPrx
@@ -2182,6 +2465,8 @@ Database::load(const ApplicationHelper& app, ServerEntrySeq& entries, const stri
     {
         entries.push_back(_serverCache.add(p->second));
     }
+
+    notifyApplicationChanged(_locatorCacheNotifier, app);
 }
 
 void
@@ -2209,6 +2494,8 @@ Database::unload(const ApplicationHelper& app, ServerEntrySeq& entries)
     {
         _nodeCache.get(n->first)->removeDescriptor(application);
     }
+
+    notifyApplicationChanged(_locatorCacheNotifier, app);
 }
 
 void
@@ -2334,6 +2621,9 @@ Database::reload(const ApplicationHelper& oldApp,
             entries.push_back(_serverCache.add(q->second));
         }
     }
+
+    notifyApplicationChanged(_locatorCacheNotifier, oldApp);
+    notifyApplicationChanged(_locatorCacheNotifier, newApp);
 }
 
 Ice::Long
@@ -2632,7 +2922,7 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
                 Lock sync(*this);
                 entries.clear();
                 ApplicationHelper previous(_communicator, newDesc);
-                ApplicationHelper helper(_communicator, oldApp.descriptor);
+                ApplicationHelper helper(_communicator, oldApp.descriptor, false, true, &previous);
 
                 ApplicationInfo info = oldApp;
                 info.revision = update.revision + 1;
@@ -14,6 +14,7 @@
 #include <IceUtil/Shared.h>
 #include <IceUtil/FileUtil.h>
 #include <Ice/CommunicatorF.h>
+#include <Ice/UniquePtr.h>
 #include <IceGrid/Admin.h>
 #include <IceGrid/Internal.h>
 #include <IceGrid/ServerCache.h>
@@ -24,6 +25,9 @@
 #include <IceGrid/AdapterCache.h>
 #include <IceGrid/Topics.h>
 #include <IceGrid/PluginFacadeI.h>
+#include <IceGrid/SnapshotMap.h>
+#include <IceGrid/LocatorCacheNotifierI.h>
+#include <IceGrid/WarmPool.h>
 
 #include <IceDB/IceDB.h>
 
@@ -68,7 +72,7 @@ public:
 
 
     Database(const Ice::ObjectAdapterPtr&, const IceStorm::TopicManagerPrx&, const std::string&, const TraceLevelsPtr&,
-             const RegistryInfo&, bool);
+             const ReapThreadPtr&, const RegistryInfo&, bool);
 
     std::string getInstanceName() const;
     bool isReadOnly() const { return _readonly; }
@@ -79,6 +83,8 @@ public:
     void destroy();
 
     ObserverTopicPtr getObserverTopic(TopicName) const;
+    const LocatorCacheNotifierIPtr& getLocatorCacheNotifier() const { return _locatorCacheNotifier; }
+    const WarmPoolPtr& getWarmPool() const { return _warmPool; }
 
     int lock(AdminSessionI*, const std::string&);
     void unlock(AdminSessionI*);
@@ -117,6 +123,7 @@ public:
     void setAdapterDirectProxy(const std::string&, const std::string&, const Ice::ObjectPrx&, Ice::Long = 0);
     Ice::ObjectPrx getAdapterDirectProxy(const std::string&, const Ice::EncodingVersion&, const Ice::ConnectionPtr&,
                                          const Ice::Context&);
+    Ice::ObjectPrx getRegisteredAdapterProxy(const std::string&) const;
 
     void removeAdapter(const std::string&);
     AdapterPrx getAdapterProxy(const std::string&, const std::string&, bool);
@@ -196,6 +203,23 @@ private:
     void addAdapter(const IceDB::ReadWriteTxn&, const AdapterInfo&);
     void deleteAdapter(const IceDB::ReadWriteTxn&, const AdapterInfo&);
 
+    struct AdapterUpdate : public IceUtil::Shared
+    {
+        AdapterInfo info;
+        Ice::Long dbSerial; // The serial requested by the caller.
+
+        AdapterInfo oldInfo;
+        bool found;
+        Ice::Long committedSerial;
+        int serial; // The adapter observer topic serial.
+        IceInternal::UniquePtr<IceUtil::Exception> exception;
+        bool done;
+    };
+    typedef IceUtil::Handle<AdapterUpdate> AdapterUpdatePtr;
+
+    void commitAdapterUpdates(const std::vector<AdapterUpdatePtr>&);
+    bool applyAdapterUpdate(const IceDB::ReadWriteTxn&, const AdapterUpdatePtr&);
+
     void addObject(const IceDB::ReadWriteTxn&, const ObjectInfo&, bool);
     void deleteObject(const IceDB::ReadWriteTxn&, const ObjectInfo&, bool);
 
@@ -221,6 +245,8 @@ private:
     ObjectCache _objectCache;
     AllocatableObjectCache _allocatableObjectCache;
     ServerCache _serverCache;
+    const LocatorCacheNotifierIPtr _locatorCacheNotifier;
+    const WarmPoolPtr _warmPool; // Only the master activates the replicas of warm pools.
 
     RegistryObserverTopicPtr _registryObserverTopic;
     NodeObserverTopicPtr _nodeObserverTopic;
@@ -244,6 +270,13 @@ private:
 
     StringLongMap _serials;
 
+    //
+    // Snapshots of the proxies of the registered adapters and objects
+    // for the locator, they're updated once the updates are committed.
+    //
+    SnapshotMap<std::string, Ice::ObjectPrx> _adapterProxies;
+    SnapshotMap<Ice::Identity, Ice::ObjectPrx> _objectProxies;
+
     RegistryPluginFacadeIPtr _pluginFacade;
 
     AdminSessionI* _lock;
@@ -288,6 +321,17 @@ private:
         }
     };
     std::vector<UpdateInfo> _updating;
+
+    //
+    // Adapter direct proxy updates are committed in batches: the updates
+    // queued while a commit is in progress are committed together with
+    // the next transaction. Object updates aren't batched, they are made
+    // with the admin interface (and replicated to the slaves), servers
+    // don't register objects with the locator registry.
+    //
+    IceUtil::Monitor<IceUtil::Mutex> _adapterUpdatesMonitor;
+    std::vector<AdapterUpdatePtr> _adapterUpdates;
+    bool _committingAdapterUpdates;
 };
 typedef IceUtil::Handle<Database> DatabasePtr;
 
@@ -7,12 +7,19 @@
 //
 // **********************************************************************
 
+#include <IceUtil/Thread.h>
+#include <IceUtil/MutexPtrLock.h>
 #include <Ice/Ice.h>
+#include <Ice/UniquePtr.h>
 #include <IceGrid/DescriptorHelper.h>
 #include <IceGrid/Util.h>
 
 #include <iterator>
 
+#ifndef _WIN32
+#   include <unistd.h>
+#endif
+
 using namespace std;
 using namespace IceUtil;
 using namespace IceUtilInternal;
@@ -386,6 +393,299 @@ validateProxyOptions(const Resolver& resolver, const string& proxyOptions)
     }
 }
 
+//
+// Return the server instance helper of the given server definition. If
+// the definition of the server didn't change since the previous
+// instantiation of its node, the previous helper and its instantiated
+// descriptor are reused instead of instantiating the server again.
+//
+template<typename Descriptor> ServerInstanceHelper
+createServerInstanceHelper(const Descriptor& desc, const Resolver& resolve, bool instantiate,
+                           const map<string, ServerInstanceHelper>* previous)
+{
+    if(previous)
+    {
+        ServerInstanceHelper helper(desc, resolve, false);
+        map<string, ServerInstanceHelper>::const_iterator p = previous->find(helper.getId());
+        if(p != previous->end() && p->second == helper)
+        {
+            return p->second;
+        }
+    }
+    return ServerInstanceHelper(desc, resolve, instantiate);
+}
+
+//
+// The instantiation of the nodes of an application. The nodes of an
+// application only depend on the application resolver so several
+// threads can instantiate them concurrently.
+//
+struct NodeInstantiation
+{
+    struct Node
+    {
+        string name;
+        const NodeDescriptor* descriptor;
+        const NodeHelper* previous;
+    };
+
+    NodeInstantiation(const vector<Node>& n, const Resolver& r) :
+        nodes(n), resolve(r), next(0), pending(n.size()), failed(n.size())
+    {
+    }
+
+    const vector<Node>& nodes;
+    const Resolver& resolve;
+    size_t next; // The next node to instantiate.
+    size_t pending; // The number of nodes not instantiated yet.
+    map<string, NodeHelper> helpers;
+    size_t failed; // The index of the first node which failed to instantiate.
+    IceInternal::UniquePtr<IceUtil::Exception> exception;
+};
+
+//
+// The threads instantiating the nodes of large applications. They are
+// started on demand and reused for the following instantiations.
+//
+class NodeInstantiatorPool : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    NodeInstantiatorPool() :
+        _destroyed(false)
+    {
+    }
+
+    void instantiate(NodeInstantiation&, size_t);
+    void run();
+    void destroy();
+
+private:
+
+    void instantiateNext(Lock&, NodeInstantiation&);
+
+    bool _destroyed;
+    vector<IceUtil::ThreadPtr> _threads;
+    list<NodeInstantiation*> _instantiations;
+};
+
+class NodeInstantiatorThread : public IceUtil::Thread
+{
+public:
+
+    NodeInstantiatorThread(NodeInstantiatorPool& pool) :
+        IceUtil::Thread("IceGrid descriptor instantiation thread"),
+        _pool(pool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _pool.run();
+    }
+
+private:
+
+    NodeInstantiatorPool& _pool;
+};
+
+void
+NodeInstantiatorPool::instantiate(NodeInstantiation& instantiation, size_t threadCount)
+{
+    Lock sync(*this);
+
+    //
+    // The calling thread instantiates nodes as well, start the missing
+    // threads. If a thread can't be started, the started threads
+    // instantiate the remaining nodes.
+    //
+    while(_threads.size() + 1 < threadCount)
+    {
+        IceUtil::ThreadPtr thread = new NodeInstantiatorThread(*this);
+        try
+        {
+            thread->start();
+        }
+        catch(const IceUtil::Exception&)
+        {
+            break;
+        }
+        _threads.push_back(thread);
+    }
+
+    _instantiations.push_back(&instantiation);
+    notifyAll();
+
+    while(instantiation.next < instantiation.nodes.size())
+    {
+        instantiateNext(sync, instantiation);
+    }
+    while(instantiation.pending > 0)
+    {
+        wait();
+    }
+
+    //
+    // Raise the exception of the first node which failed, as if the
+    // nodes were instantiated in order.
+    //
+    if(instantiation.exception.get())
+    {
+        instantiation.exception->ice_throw();
+    }
+}
+
+void
+NodeInstantiatorPool::run()
+{
+    Lock sync(*this);
+    while(true)
+    {
+        while(!_destroyed && _instantiations.empty())
+        {
+            wait();
+        }
+        if(_destroyed)
+        {
+            return;
+        }
+        instantiateNext(sync, *_instantiations.front());
+    }
+}
+
+void
+NodeInstantiatorPool::destroy()
+{
+    vector<IceUtil::ThreadPtr> threads;
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+        threads.swap(_threads);
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
+
+void
+NodeInstantiatorPool::instantiateNext(Lock& sync, NodeInstantiation& instantiation)
+{
+    assert(instantiation.next < instantiation.nodes.size());
+    size_t i = instantiation.next++;
+    if(instantiation.next == instantiation.nodes.size())
+    {
+        _instantiations.remove(&instantiation);
+    }
+    const NodeInstantiation::Node& node = instantiation.nodes[i];
+
+    sync.release();
+    vector<NodeHelper> helper;
+    IceUtil::Exception* exception = 0;
+    try
+    {
+        helper.push_back(NodeHelper(node.name, *node.descriptor, instantiation.resolve, true, node.previous));
+    }
+    catch(const IceUtil::Exception& ex)
+    {
+        exception = ex.ice_clone();
+    }
+    catch(const std::exception& ex)
+    {
+        exception = new Ice::UnknownException(__FILE__, __LINE__, ex.what());
+    }
+    catch(...)
+    {
+        exception = new Ice::UnknownException(__FILE__, __LINE__, "unknown c++ exception");
+    }
+    sync.acquire();
+
+    if(exception)
+    {
+        //
+        // Keep the exception of the first node and don't instantiate
+        // the nodes which aren't started yet.
+        //
+        if(i < instantiation.failed)
+        {
+            instantiation.failed = i;
+            instantiation.exception.reset(exception);
+        }
+        else
+        {
+            delete exception;
+        }
+        if(instantiation.next < instantiation.nodes.size())
+        {
+            instantiation.pending -= instantiation.nodes.size() - instantiation.next;
+            instantiation.next = instantiation.nodes.size();
+            _instantiations.remove(&instantiation);
+        }
+    }
+    else
+    {
+        instantiation.helpers.insert(make_pair(node.name, helper.back()));
+    }
+
+    if(--instantiation.pending == 0)
+    {
+        notifyAll();
+    }
+}
+
+IceUtil::Mutex* nodeInstantiatorPoolMutex = 0;
+NodeInstantiatorPool* nodeInstantiatorPool = 0;
+
+class Init
+{
+public:
+
+    Init()
+    {
+        nodeInstantiatorPoolMutex = new IceUtil::Mutex;
+    }
+
+    ~Init()
+    {
+        if(nodeInstantiatorPool)
+        {
+            nodeInstantiatorPool->destroy();
+            delete nodeInstantiatorPool;
+            nodeInstantiatorPool = 0;
+        }
+        delete nodeInstantiatorPoolMutex;
+        nodeInstantiatorPoolMutex = 0;
+    }
+};
+
+Init init;
+
+NodeInstantiatorPool&
+getNodeInstantiatorPool()
+{
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> sync(nodeInstantiatorPoolMutex);
+    if(!nodeInstantiatorPool)
+    {
+        nodeInstantiatorPool = new NodeInstantiatorPool();
+    }
+    return *nodeInstantiatorPool;
+}
+
+int
+getProcessorCount()
+{
+#ifdef _WIN32
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return static_cast<int>(sysInfo.dwNumberOfProcessors);
+#else
+    return static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+}
+
 }
 
 Resolver::Resolver(const ApplicationDescriptor& app, const Ice::CommunicatorPtr& communicator, bool enableWarning) :
@@ -2179,7 +2479,8 @@ ServerInstanceHelper::getReplicaGroups(set<string>& replicaGroups) const
 NodeHelper::NodeHelper(const string& name,
                        const NodeDescriptor& descriptor,
                        const Resolver& appResolve,
-                       bool instantiate) :
+                       bool instantiate,
+                       const NodeHelper* previous) :
     _name(name),
     _def(descriptor),
     _instantiated(instantiate)
@@ -2211,9 +2512,21 @@ NodeHelper::NodeHelper(const string& name,
         resolve.addPropertySets(_instance.propertySets);
     }
 
+    //
+    // The servers of the previous instantiation of this node can be
+    // reused if the node variables and property sets didn't change. The
+    // caller ensures the application resolver didn't change either.
+    //
+    if(!instantiate || !previous || !previous->_instantiated || previous->_name != _name ||
+       previous->_def.variables != _def.variables || previous->_def.propertySets != _def.propertySets)
+    {
+        previous = 0;
+    }
+
     for(ServerInstanceDescriptorSeq::const_iterator p = _def.serverInstances.begin(); p != _def.serverInstances.end(); ++p)
     {
-        ServerInstanceHelper helper(*p, resolve, instantiate);
+        ServerInstanceHelper helper = createServerInstanceHelper(*p, resolve, instantiate,
+                                                                 previous ? &previous->_serverInstances : 0);
         if(!_serverInstances.insert(make_pair(helper.getId(), helper)).second)
         {
             resolve.exception("duplicate server `" + helper.getId() + "' in node `" + _name + "'");
@@ -2226,7 +2539,8 @@ NodeHelper::NodeHelper(const string& name,
 
     for(ServerDescriptorSeq::const_iterator q = _def.servers.begin(); q != _def.servers.end(); ++q)
     {
-        ServerInstanceHelper helper(*q, resolve, instantiate);
+        ServerInstanceHelper helper = createServerInstanceHelper(*q, resolve, instantiate,
+                                                                 previous ? &previous->_servers : 0);
         if(!_servers.insert(make_pair(helper.getId(), helper)).second)
         {
             resolve.exception("duplicate server `" + helper.getId() + "' in node `" + _name + "'");
@@ -2695,7 +3009,8 @@ NodeHelper::printDiff(Output& out, const NodeHelper& helper) const
 ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
                                      const ApplicationDescriptor& desc,
                                      bool enableWarning,
-                                     bool instantiate) :
+                                     bool instantiate,
+                                     const ApplicationHelper* previous) :
     _communicator(communicator),
     _def(desc)
 {
@@ -2747,9 +3062,10 @@ ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
             if(al)
             {
                 al->loadSample = resolve(al->loadSample, "replica group load sample");
-                if(al->loadSample != "" && al->loadSample != "1" && al->loadSample != "5" && al->loadSample != "15")
+                if(al->loadSample != "" && al->loadSample != "1" && al->loadSample != "5" && al->loadSample != "15" &&
+                   al->loadSample != "dispatch")
                 {
-                    resolve.exception("invalid load sample value (allowed values are 1, 5 or 15)");
+                    resolve.exception("invalid load sample value (allowed values are 1, 5, 15 or dispatch)");
                 }
             }
             _instance.replicaGroups.push_back(desc);
@@ -2763,13 +3079,63 @@ ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
         resolve.addPropertySets(_instance.propertySets);
     }
 
+    //
+    // The servers of the previous instantiation of the application can
+    // only be reused if the application resolver didn't change.
+    //
+    if(!instantiate || !previous || !isResolverEqual(*previous))
+    {
+        previous = 0;
+    }
+
+    //
+    // Instantiate the nodes of large applications with several threads.
+    //
+    vector<NodeInstantiation::Node> nodes;
+    size_t serverCount = 0;
+    for(NodeDescriptorDict::const_iterator p = _def.nodes.begin(); p != _def.nodes.end(); ++p)
+    {
+        NodeInstantiation::Node node;
+        node.name = p->first;
+        node.descriptor = &p->second;
+        node.previous = 0;
+        if(previous)
+        {
+            NodeHelperDict::const_iterator q = previous->_nodes.find(p->first);
+            if(q != previous->_nodes.end())
+            {
+                node.previous = &q->second;
+            }
+        }
+        nodes.push_back(node);
+        serverCount += p->second.serverInstances.size() + p->second.servers.size();
+    }
+
+    NodeInstantiation instantiation(nodes, resolve);
+    size_t threadCount = static_cast<size_t>(min(max(getProcessorCount(), 1), 8));
+    size_t threshold = static_cast<size_t>(max(0, _communicator->getProperties()->getPropertyAsIntWithDefault(
+                                                      "IceGrid.Registry.ParallelInstantiationThreshold", 100)));
+    if(instantiate && nodes.size() > 1 && threadCount > 1 && serverCount >= threshold)
+    {
+        getNodeInstantiatorPool().instantiate(instantiation, min(threadCount, nodes.size()));
+    }
+
     //
     // Create the node helpers.
     //
     NodeHelperDict::const_iterator n;
-    for(NodeDescriptorDict::const_iterator p = _def.nodes.begin(); p != _def.nodes.end(); ++p)
+    for(vector<NodeInstantiation::Node>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
     {
-        n = _nodes.insert(make_pair(p->first, NodeHelper(p->first, p->second, resolve, instantiate))).first;
+        map<string, NodeHelper>::const_iterator q = instantiation.helpers.find(p->name);
+        if(q != instantiation.helpers.end())
+        {
+            n = _nodes.insert(*q).first;
+        }
+        else
+        {
+            n = _nodes.insert(make_pair(p->name,
+                                        NodeHelper(p->name, *p->descriptor, resolve, instantiate, p->previous))).first;
+        }
         if(instantiate)
         {
             _instance.nodes.insert(make_pair(n->first, n->second.getInstance()));
@@ -2831,6 +3197,36 @@ ApplicationHelper::ApplicationHelper(const Ice::CommunicatorPtr& communicator,
     }
 }
 
+bool
+ApplicationHelper::isResolverEqual(const ApplicationHelper& helper) const
+{
+    //
+    // The node and server instantiation depends on the application
+    // name, variables, property sets, templates and replica groups.
+    //
+    if(_def.name != helper._def.name || _def.variables != helper._def.variables ||
+       _def.propertySets != helper._def.propertySets)
+    {
+        return false;
+    }
+
+    TemplateDescriptorEqual eq;
+    if(!getDictUpdatedEltsWithEq(helper._def.serverTemplates, _def.serverTemplates, eq).empty() ||
+       !getDictRemovedElts(helper._def.serverTemplates, _def.serverTemplates).empty() ||
+       !getDictUpdatedEltsWithEq(helper._def.serviceTemplates, _def.serviceTemplates, eq).empty() ||
+       !getDictRemovedElts(helper._def.serviceTemplates, _def.serviceTemplates).empty())
+    {
+        return false;
+    }
+
+    set<string> replicaGroups;
+    transform(_def.replicaGroups.begin(), _def.replicaGroups.end(), set_inserter(replicaGroups), GetReplicaGroupId());
+    set<string> previousReplicaGroups;
+    transform(helper._def.replicaGroups.begin(), helper._def.replicaGroups.end(), set_inserter(previousReplicaGroups),
+              GetReplicaGroupId());
+    return replicaGroups == previousReplicaGroups;
+}
+
 ApplicationUpdateDescriptor
 ApplicationHelper::diff(const ApplicationHelper& helper) const
 {
@@ -3372,6 +3768,11 @@ ApplicationHelper::printDiff(Output& out, const ApplicationHelper& helper) const
 bool
 IceGrid::descriptorEqual(const ServerDescriptorPtr& lhs, const ServerDescriptorPtr& rhs, bool ignoreProps)
 {
+    if(lhs == rhs)
+    {
+        return true; // The server wasn't instantiated again, see createServerInstanceHelper()
+    }
+
     IceBoxDescriptorPtr lhsIceBox = IceBoxDescriptorPtr::dynamicCast(lhs);
     IceBoxDescriptorPtr rhsIceBox = IceBoxDescriptorPtr::dynamicCast(rhs);
     if(lhsIceBox && rhsIceBox)
@@ -278,7 +278,7 @@ class NodeHelper
 {
 public:
 
-    NodeHelper(const std::string&, const NodeDescriptor&, const Resolver&, bool);
+    NodeHelper(const std::string&, const NodeDescriptor&, const Resolver&, bool, const NodeHelper* = 0);
     virtual ~NodeHelper() { }
 
     virtual bool operator==(const NodeHelper&) const;
@@ -316,7 +316,8 @@ class ApplicationHelper
 {
 public:
 
-    ApplicationHelper(const Ice::CommunicatorPtr&, const ApplicationDescriptor&, bool = false, bool = true);
+    ApplicationHelper(const Ice::CommunicatorPtr&, const ApplicationDescriptor&, bool = false, bool = true,
+                      const ApplicationHelper* = 0);
 
     ApplicationUpdateDescriptor diff(const ApplicationHelper&) const;
     ApplicationDescriptor update(const ApplicationUpdateDescriptor&) const;
@@ -334,6 +335,8 @@ public:
 
 private:
 
+    bool isResolverEqual(const ApplicationHelper&) const;
+
     Ice::CommunicatorPtr _communicator;
     ApplicationDescriptor _def;
     ApplicationDescriptor _instance;
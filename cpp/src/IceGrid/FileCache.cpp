@@ -18,14 +18,47 @@
 #include <deque>
 #include <fstream>
 
+#ifdef ICEGRID_USE_INOTIFY
+#   include <sys/inotify.h>
+#   include <unistd.h>
+#endif
+
 using namespace std;
 using namespace IceGrid;
 
+#ifdef ICEGRID_USE_INOTIFY
+namespace
+{
+
+//
+// inotify watches are limited per user, only watch the files most
+// recently read.
+//
+const size_t maxWatchedFiles = 512;
+
+}
+#endif
+
 FileCache::FileCache(const Ice::CommunicatorPtr& com) : 
     _messageSizeMax(com->getProperties()->getPropertyAsIntWithDefault("Ice.MessageSizeMax", 1024) * 1024 - 256)
+#ifdef ICEGRID_USE_INOTIFY
+    , _inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+    _readCount(0),
+    _generation(0)
+#endif
 {
 }
 
+FileCache::~FileCache()
+{
+#ifdef ICEGRID_USE_INOTIFY
+    if(_inotifyFd >= 0)
+    {
+        close(_inotifyFd);
+    }
+#endif
+}
+
 Ice::Long
 FileCache::getOffsetFromEnd(const string& file, int originalCount)
 {
@@ -141,6 +174,20 @@ FileCache::read(const string& file, Ice::Long offset, int size, Ice::Long& newOf
         throw FileNotAvailableException("maximum bytes per read request is too low");
     }
 
+#ifdef ICEGRID_USE_INOTIFY
+    if(isUnmodifiedEnd(file, offset, newOffset))
+    {
+        lines = Ice::StringSeq();
+        return true;
+    }
+
+    //
+    // Watch the file before reading it, a modification made while the
+    // file is read will be noticed by the next read.
+    //
+    Ice::Long generation = watch(file);
+#endif
+
     ifstream is(IceUtilInternal::streamFilename(file).c_str()); // file is a UTF-8 string
     if(is.fail())
     {
@@ -153,6 +200,9 @@ FileCache::read(const string& file, Ice::Long offset, int size, Ice::Long& newOf
     // the EOF.
     //
     is.seekg(0, ios::end);
+#ifdef ICEGRID_USE_INOTIFY
+    setSize(file, generation, is.tellg());
+#endif
     if(offset >= is.tellg())
     {
         newOffset = is.tellg();
@@ -216,3 +266,166 @@ FileCache::read(const string& file, Ice::Long offset, int size, Ice::Long& newOf
     return is.eof();
 }
 
+#ifdef ICEGRID_USE_INOTIFY
+
+bool
+FileCache::isUnmodifiedEnd(const string& file, Ice::Long offset, Ice::Long& newOffset)
+{
+    Lock sync(*this);
+    if(_inotifyFd < 0)
+    {
+        return false;
+    }
+
+    readEvents();
+
+    map<string, WatchedFile>::iterator p = _files.find(file);
+    if(p == _files.end() || p->second.modified || p->second.size < 0 || offset < p->second.size)
+    {
+        return false;
+    }
+    p->second.lastRead = ++_readCount;
+    newOffset = offset;
+    return true;
+}
+
+Ice::Long
+FileCache::watch(const string& file)
+{
+    Lock sync(*this);
+    if(_inotifyFd < 0)
+    {
+        return -1;
+    }
+
+    map<string, WatchedFile>::iterator p = _files.find(file);
+    if(p != _files.end())
+    {
+        p->second.size = -1;
+        p->second.modified = false;
+        p->second.lastRead = ++_readCount;
+        p->second.generation = ++_generation;
+        return p->second.generation;
+    }
+
+    if(_files.size() >= maxWatchedFiles)
+    {
+        map<string, WatchedFile>::iterator lru = _files.begin();
+        for(map<string, WatchedFile>::iterator q = _files.begin(); q != _files.end(); ++q)
+        {
+            if(q->second.lastRead < lru->second.lastRead)
+            {
+                lru = q;
+            }
+        }
+        unwatch(lru);
+    }
+
+    int wd = inotify_add_watch(_inotifyFd, IceUtilInternal::streamFilename(file).c_str(),
+                               IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF);
+    if(wd < 0 || _watches.find(wd) != _watches.end())
+    {
+        //
+        // The file can't be watched or it's already watched under
+        // another name, it's read on each request.
+        //
+        return -1;
+    }
+
+    WatchedFile watched;
+    watched.wd = wd;
+    watched.size = -1;
+    watched.modified = false;
+    watched.lastRead = ++_readCount;
+    watched.generation = ++_generation;
+    _files.insert(make_pair(file, watched));
+    _watches.insert(make_pair(wd, file));
+    return watched.generation;
+}
+
+void
+FileCache::setSize(const string& file, Ice::Long generation, Ice::Long size)
+{
+    //
+    // Only keep the size if the file wasn't read again or modified
+    // since it was watched by this read, the size might otherwise be
+    // stale.
+    //
+    Lock sync(*this);
+    map<string, WatchedFile>::iterator p = _files.find(file);
+    if(p != _files.end() && p->second.generation == generation)
+    {
+        p->second.size = size;
+    }
+}
+
+void
+FileCache::readEvents()
+{
+    long buffer[4096 / sizeof(long)]; // Aligned for inotify_event.
+    while(true)
+    {
+        ssize_t sz = ::read(_inotifyFd, buffer, sizeof(buffer));
+        if(sz <= 0)
+        {
+            return; // No more events to read (EAGAIN).
+        }
+
+        const char* end = reinterpret_cast<const char*>(buffer) + sz;
+        for(const char* p = reinterpret_cast<const char*>(buffer); p < end;)
+        {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW)
+            {
+                //
+                // Events were lost, the files must be read again.
+                //
+                for(map<string, WatchedFile>::iterator q = _files.begin(); q != _files.end(); ++q)
+                {
+                    q->second.modified = true;
+                    q->second.generation = ++_generation;
+                }
+                continue;
+            }
+
+            map<int, string>::const_iterator w = _watches.find(event->wd);
+            if(w == _watches.end())
+            {
+                continue;
+            }
+
+            map<string, WatchedFile>::iterator q = _files.find(w->second);
+            assert(q != _files.end());
+            if(event->mask & IN_IGNORED)
+            {
+                _watches.erase(event->wd);
+                _files.erase(q);
+            }
+            else if(event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+            {
+                //
+                // The file was removed or rotated, the file with the same
+                // name will be watched when it's read.
+                //
+                unwatch(q);
+            }
+            else
+            {
+                q->second.modified = true;
+                q->second.generation = ++_generation;
+            }
+        }
+    }
+}
+
+void
+FileCache::unwatch(map<string, WatchedFile>::iterator p)
+{
+    inotify_rm_watch(_inotifyFd, p->second.wd);
+    _watches.erase(p->second.wd);
+    _files.erase(p);
+}
+
+#endif
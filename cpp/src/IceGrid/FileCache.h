@@ -11,17 +11,31 @@
 #define ICE_GRID_FILE_CACHE_H
 
 #include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
 #include <Ice/BuiltinSequences.h>
 #include <Ice/CommunicatorF.h>
 
+#include <map>
+
+#if defined(__linux)
+#   define ICEGRID_USE_INOTIFY 1
+#endif
+
 namespace IceGrid
 {
 
-class FileCache : public IceUtil::Shared
+//
+// On Linux, the cache watches the files read until their end with
+// inotify. A read request at the end of a file which wasn't modified
+// since it was last read is answered without opening the file, this
+// makes the polling of idle files by file iterators cheap.
+//
+class FileCache : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
 
     FileCache(const Ice::CommunicatorPtr&);
+    ~FileCache();
 
     Ice::Long getOffsetFromEnd(const std::string&, int);
     bool read(const std::string&, Ice::Long, int, Ice::Long&, Ice::StringSeq&);
@@ -29,6 +43,29 @@ public:
 private:
 
     const int _messageSizeMax;
+
+#ifdef ICEGRID_USE_INOTIFY
+    struct WatchedFile
+    {
+        int wd; // The inotify watch descriptor.
+        Ice::Long size; // The size of the file when it was last read.
+        bool modified; // Was the file modified since it was last read?
+        Ice::Long lastRead; // The sequence number of the last read.
+        Ice::Long generation; // Changed by each read and modification of the file.
+    };
+
+    bool isUnmodifiedEnd(const std::string&, Ice::Long, Ice::Long&);
+    Ice::Long watch(const std::string&);
+    void setSize(const std::string&, Ice::Long, Ice::Long);
+    void readEvents();
+    void unwatch(std::map<std::string, WatchedFile>::iterator);
+
+    int _inotifyFd;
+    Ice::Long _readCount;
+    Ice::Long _generation;
+    std::map<std::string, WatchedFile> _files;
+    std::map<int, std::string> _watches;
+#endif
 };
 typedef IceUtil::Handle<FileCache> FileCachePtr;
 
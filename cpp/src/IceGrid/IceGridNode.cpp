@@ -503,6 +503,11 @@ NodeService::startImpl(int argc, char* argv[], int& status)
     //
     _sessions->create(_node);
 
+    //
+    // Start collecting the dispatch load of the servers if enabled.
+    //
+    _node->startServerLoadsCollection();
+
     //
     // Create Admin unless there is a collocated registry with its own Admin
     //
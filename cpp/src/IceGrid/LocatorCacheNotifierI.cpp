@@ -0,0 +1,227 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceGrid/LocatorCacheNotifierI.h>
+#include <IceGrid/AdapterCache.h>
+
+using namespace std;
+using namespace IceGrid;
+
+namespace
+{
+
+class ObserverCallback : public IceUtil::Shared
+{
+public:
+
+    ObserverCallback(const LocatorCacheNotifierIPtr& notifier, const Ice::ConnectionPtr& connection) :
+        _notifier(notifier),
+        _connection(connection)
+    {
+    }
+
+    void exception(const Ice::Exception& ex)
+    {
+        ostringstream os;
+        os << ex;
+        _notifier->removeObserver(_connection, os.str());
+    }
+
+private:
+
+    const LocatorCacheNotifierIPtr _notifier;
+    const Ice::ConnectionPtr _connection;
+};
+typedef IceUtil::Handle<ObserverCallback> ObserverCallbackPtr;
+
+//
+// Registered with the reaper to remove the observer when its
+// connection is closed.
+//
+class ObserverReapable : public Reapable
+{
+public:
+
+    ObserverReapable(const LocatorCacheNotifierIPtr& notifier, const Ice::ConnectionPtr& connection) :
+        _notifier(notifier),
+        _connection(connection)
+    {
+    }
+
+    virtual IceUtil::Time
+    timestamp() const
+    {
+        if(!_notifier->hasObserver(_connection))
+        {
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+        return IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
+    virtual void
+    destroy(bool shutdown)
+    {
+        _notifier->removeObserver(_connection, shutdown ? "registry shutdown" : "connection closed");
+    }
+
+private:
+
+    const LocatorCacheNotifierIPtr _notifier;
+    const Ice::ConnectionPtr _connection;
+};
+
+}
+
+LocatorCacheNotifierI::LocatorCacheNotifierI(AdapterCache& adapterCache, const ReapThreadPtr& reaper,
+                                             const TraceLevelsPtr& traceLevels) :
+    _adapterCache(adapterCache),
+    _reaper(reaper),
+    _traceLevels(traceLevels)
+{
+}
+
+void
+LocatorCacheNotifierI::addObserver(const Ice::LocatorCacheObserverPrx& observer, const Ice::Current& current)
+{
+    if(!observer || !current.con)
+    {
+        return;
+    }
+
+    //
+    // The observer is called with oneway requests over the connection
+    // used to add it.
+    //
+    Ice::LocatorCacheObserverPrx proxy = Ice::LocatorCacheObserverPrx::uncheckedCast(
+        current.con->createProxy(observer->ice_getIdentity())->ice_oneway());
+
+    {
+        Lock sync(*this);
+        map<Ice::ConnectionPtr, Ice::LocatorCacheObserverPrx>::iterator p = _observers.find(current.con);
+        if(p != _observers.end())
+        {
+            p->second = proxy;
+            return;
+        }
+        _observers.insert(make_pair(current.con, proxy));
+
+        if(_traceLevels->locator > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->locatorCat);
+            out << "added locator cache observer\nconnection = " << current.con->toString();
+        }
+    }
+
+    //
+    // The reaper calls back the notifier when the connection is closed,
+    // it must be called without holding the notifier mutex.
+    //
+    _reaper->add(new ObserverReapable(this, current.con), 0, current.con);
+}
+
+void
+LocatorCacheNotifierI::adapterChanged(const string& id, const string& replicaGroupId)
+{
+    vector<Ice::LocatorCacheObserverPrx> observers = getObservers();
+    for(vector<Ice::LocatorCacheObserverPrx>::const_iterator p = observers.begin(); p != observers.end(); ++p)
+    {
+        ObserverCallbackPtr cb = new ObserverCallback(this, (*p)->ice_getCachedConnection());
+        try
+        {
+            (*p)->begin_adapterChanged(id, Ice::newCallback_LocatorCacheObserver_adapterChanged(
+                                           cb, &ObserverCallback::exception));
+            if(!replicaGroupId.empty())
+            {
+                (*p)->begin_adapterChanged(replicaGroupId, Ice::newCallback_LocatorCacheObserver_adapterChanged(
+                                               cb, &ObserverCallback::exception));
+            }
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            cb->exception(ex);
+        }
+    }
+}
+
+void
+LocatorCacheNotifierI::serverAdapterChanged(const string& id)
+{
+    string replicaGroupId;
+    try
+    {
+        ServerAdapterEntryPtr adapter = ServerAdapterEntryPtr::dynamicCast(_adapterCache.get(id));
+        if(adapter)
+        {
+            replicaGroupId = adapter->getReplicaGroupId();
+        }
+    }
+    catch(const AdapterNotExistException&)
+    {
+    }
+    adapterChanged(id, replicaGroupId);
+}
+
+void
+LocatorCacheNotifierI::objectChanged(const Ice::Identity& id)
+{
+    vector<Ice::LocatorCacheObserverPrx> observers = getObservers();
+    for(vector<Ice::LocatorCacheObserverPrx>::const_iterator p = observers.begin(); p != observers.end(); ++p)
+    {
+        ObserverCallbackPtr cb = new ObserverCallback(this, (*p)->ice_getCachedConnection());
+        try
+        {
+            (*p)->begin_objectChanged(id, Ice::newCallback_LocatorCacheObserver_objectChanged(
+                                          cb, &ObserverCallback::exception));
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            cb->exception(ex);
+        }
+    }
+}
+
+bool
+LocatorCacheNotifierI::hasObservers() const
+{
+    Lock sync(*this);
+    return !_observers.empty();
+}
+
+bool
+LocatorCacheNotifierI::hasObserver(const Ice::ConnectionPtr& connection) const
+{
+    Lock sync(*this);
+    return _observers.find(connection) != _observers.end();
+}
+
+void
+LocatorCacheNotifierI::removeObserver(const Ice::ConnectionPtr& connection, const string& reason)
+{
+    Lock sync(*this);
+    if(_observers.erase(connection) > 0 && _traceLevels->locator > 1)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->locatorCat);
+        out << "removed locator cache observer\nconnection = " << connection->toString() << "\nreason = " << reason;
+    }
+}
+
+vector<Ice::LocatorCacheObserverPrx>
+LocatorCacheNotifierI::getObservers()
+{
+    Lock sync(*this);
+    vector<Ice::LocatorCacheObserverPrx> observers;
+    observers.reserve(_observers.size());
+    for(map<Ice::ConnectionPtr, Ice::LocatorCacheObserverPrx>::const_iterator p = _observers.begin();
+        p != _observers.end(); ++p)
+    {
+        observers.push_back(p->second);
+    }
+    return observers;
+}
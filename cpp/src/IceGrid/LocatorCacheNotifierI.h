@@ -0,0 +1,62 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_GRID_LOCATOR_CACHE_NOTIFIER_I_H
+#define ICE_GRID_LOCATOR_CACHE_NOTIFIER_I_H
+
+#include <IceUtil/Mutex.h>
+#include <Ice/Locator.h>
+#include <IceGrid/TraceLevels.h>
+#include <IceGrid/ReapThread.h>
+
+namespace IceGrid
+{
+
+class AdapterCache;
+
+//
+// The locator cache notifier is provided by the locator objects with
+// the `LocatorCache' facet. Clients add an observer to be notified of
+// the changes of the adapters and objects they might have cached.
+// Observers are called over the connection used to add them, they're
+// removed when this connection is closed or when a notification can't
+// be sent.
+//
+class LocatorCacheNotifierI : public Ice::LocatorCacheNotifier, public IceUtil::Mutex
+{
+public:
+
+    LocatorCacheNotifierI(AdapterCache&, const ReapThreadPtr&, const TraceLevelsPtr&);
+
+    virtual void addObserver(const Ice::LocatorCacheObserverPrx&, const Ice::Current&);
+
+    void adapterChanged(const std::string&, const std::string& = std::string());
+    void serverAdapterChanged(const std::string&); // Also notifies the change of the adapter replica group.
+    void objectChanged(const Ice::Identity&);
+
+    bool hasObservers() const;
+    bool hasObserver(const Ice::ConnectionPtr&) const;
+
+    void removeObserver(const Ice::ConnectionPtr&, const std::string&);
+
+private:
+
+    std::vector<Ice::LocatorCacheObserverPrx> getObservers();
+
+    AdapterCache& _adapterCache;
+    const ReapThreadPtr _reaper;
+    const TraceLevelsPtr _traceLevels;
+
+    std::map<Ice::ConnectionPtr, Ice::LocatorCacheObserverPrx> _observers;
+};
+typedef IceUtil::Handle<LocatorCacheNotifierI> LocatorCacheNotifierIPtr;
+
+}
+
+#endif
@@ -853,6 +853,18 @@ LocatorI::findAdapterById_async(const Ice::AMD_Locator_findAdapterByIdPtr& cb,
                                 const string& id,
                                 const Ice::Current& current) const
 {
+    //
+    // Adapters registered with the locator registry are returned from
+    // the database snapshot without locking the database. Their ids
+    // can't clash with the ids of application adapters.
+    //
+    Ice::ObjectPrx proxy = _database->getRegisteredAdapterProxy(id);
+    if(proxy)
+    {
+        cb->ice_response(proxy);
+        return;
+    }
+
     LocatorIPtr self = const_cast<LocatorI*>(this);
     bool replicaGroup = false;
     try
@@ -32,6 +32,7 @@ local_registry_srcs 	= Internal.ice \
 			  DescriptorHelper.cpp \
 			  FileUserAccountMapperI.cpp \
 			  InternalRegistryI.cpp \
+			  LocatorCacheNotifierI.cpp \
 			  LocatorI.cpp \
 			  LocatorRegistryI.cpp \
 			  NodeCache.cpp \
@@ -50,6 +51,7 @@ local_registry_srcs 	= Internal.ice \
 			  SessionServantManager.cpp \
 			  Topics.cpp \
 			  Util.cpp \
+			  WarmPool.cpp \
 			  WellKnownObjectsManager.cpp
 
 local_admin_srcs	= Internal.ice \
@@ -530,6 +530,13 @@ NodeEntry::getLoadInfoAndLoadFactor(const string& application, float& loadFactor
     return _session->getLoadInfo();
 }
 
+bool
+NodeEntry::getServerLoad(const string& server, ServerLoad& load) const
+{
+    Lock sync(*this);
+    return _session && !_session->isDestroyed() && _session->getServerLoad(server, load);
+}
+
 NodeSessionIPtr
 NodeEntry::getSession() const
 {
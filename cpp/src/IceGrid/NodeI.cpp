@@ -277,6 +277,52 @@ private:
     AdapterDynamicInfo _info;
 };
 
+class CollectServerLoadsTask : public IceUtil::TimerTask
+{
+public:
+
+    CollectServerLoadsTask(const NodeIPtr& node) : _node(node)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _node->collectServerLoads();
+    }
+
+private:
+
+    const NodeIPtr _node;
+};
+
+class ServerLoadCallback : public IceUtil::Shared
+{
+public:
+
+    ServerLoadCallback(const NodeIPtr& node, const string& id) : _node(node), _id(id)
+    {
+    }
+
+    void
+    response(const IceMX::MetricsView& view, Ice::Long)
+    {
+        _node->serverLoadCollected(_id, view);
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        _node->serverLoadFailed(_id);
+    }
+
+private:
+
+    const NodeIPtr _node;
+    const string _id;
+};
+typedef IceUtil::Handle<ServerLoadCallback> ServerLoadCallbackPtr;
+
 }
 
 NodeI::Update::Update(const NodeIPtr& node, const NodeObserverPrx& observer) : _node(node), _observer(observer)
@@ -318,7 +364,8 @@ NodeI::NodeI(const Ice::ObjectAdapterPtr& adapter,
     _platform("IceGrid.Node", _communicator, _traceLevels),
     _fileCache(new FileCache(_communicator)),
     _serial(1),
-    _consistencyCheckDone(false)
+    _consistencyCheckDone(false),
+    _dispatchMetricsView(adapter->getCommunicator()->getProperties()->getProperty("IceGrid.Node.DispatchMetricsView"))
 {
     Ice::PropertiesPtr props = _communicator->getProperties();
 
@@ -763,6 +810,167 @@ NodeI::shutdown()
     _serversByApplication.clear();
 }
 
+void
+NodeI::startServerLoadsCollection()
+{
+    //
+    // The dispatch load of the servers is only collected if the servers
+    // are configured with the metrics view used to compute the load.
+    //
+    if(!_dispatchMetricsView.empty())
+    {
+        _timer->scheduleRepeated(new CollectServerLoadsTask(this), IceUtil::Time::seconds(1));
+    }
+}
+
+void
+NodeI::collectServerLoads()
+{
+    //
+    // Send the loads collected by the previous run to the registries.
+    // The registries which don't support server loads ignore the call.
+    //
+    ServerLoadSeq loads;
+    {
+        IceUtil::Mutex::Lock sync(_serverLoadsMutex);
+        for(map<string, ServerLoadSample>::const_iterator p = _serverLoads.begin(); p != _serverLoads.end(); ++p)
+        {
+            loads.push_back(p->second.load);
+        }
+    }
+
+    vector<NodeSessionPrx> sessions;
+    {
+        IceUtil::Mutex::Lock sync(_observerMutex);
+        for(map<NodeSessionPrx, NodeObserverPrx>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
+        {
+            sessions.push_back(p->first);
+        }
+    }
+
+    for(vector<NodeSessionPrx>::const_iterator p = sessions.begin(); p != sessions.end(); ++p)
+    {
+        try
+        {
+            (*p)->begin_setServerLoads(loads);
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+    }
+
+    //
+    // Get the dispatch metrics of the active servers, the load of the
+    // servers which are no longer active is dropped.
+    //
+    vector<ServerIPtr> servers;
+    {
+        IceUtil::Mutex::Lock sync(_serversLock);
+        for(map<string, set<ServerIPtr> >::const_iterator p = _serversByApplication.begin();
+            p != _serversByApplication.end(); ++p)
+        {
+            servers.insert(servers.end(), p->second.begin(), p->second.end());
+        }
+    }
+
+    set<string> active;
+    for(vector<ServerIPtr>::const_iterator p = servers.begin(); p != servers.end(); ++p)
+    {
+        Ice::ObjectPrx process = (*p)->getProcess();
+        if(!process)
+        {
+            continue;
+        }
+
+        const string id = (*p)->getId();
+        active.insert(id);
+
+        ServerLoadCallbackPtr cb = new ServerLoadCallback(this, id);
+        try
+        {
+            IceMX::MetricsAdminPrx::uncheckedCast(process->ice_facet("Metrics"))->begin_getMetricsView(
+                _dispatchMetricsView, IceMX::newCallback_MetricsAdmin_getMetricsView(cb,
+                                                                                     &ServerLoadCallback::response,
+                                                                                     &ServerLoadCallback::exception));
+        }
+        catch(const Ice::LocalException&)
+        {
+            active.erase(id);
+        }
+    }
+
+    IceUtil::Mutex::Lock sync(_serverLoadsMutex);
+    map<string, ServerLoadSample>::iterator p = _serverLoads.begin();
+    while(p != _serverLoads.end())
+    {
+        if(active.find(p->first) == active.end())
+        {
+            _serverLoads.erase(p++);
+        }
+        else
+        {
+            ++p;
+        }
+    }
+}
+
+void
+NodeI::serverLoadCollected(const string& id, const IceMX::MetricsView& view)
+{
+    Ice::Int current = 0;
+    Ice::Long completed = 0;
+    Ice::Long lifetime = 0;
+    IceMX::MetricsView::const_iterator p = view.find("Dispatch");
+    if(p != view.end())
+    {
+        for(IceMX::MetricsMap::const_iterator q = p->second.begin(); q != p->second.end(); ++q)
+        {
+            current += (*q)->current;
+            completed += (*q)->total - (*q)->current;
+            lifetime += (*q)->totalLifetime;
+        }
+    }
+
+    IceUtil::Mutex::Lock sync(_serverLoadsMutex);
+    map<string, ServerLoadSample>::iterator s = _serverLoads.find(id);
+    if(s == _serverLoads.end())
+    {
+        ServerLoadSample sample;
+        sample.load.id = id;
+        sample.load.current = 0;
+        sample.load.latency = 0.0f;
+        sample.completed = -1;
+        sample.lifetime = 0;
+        s = _serverLoads.insert(make_pair(id, sample)).first;
+    }
+
+    //
+    // The latency of the requests completed since the previous sample
+    // is added to the moving average. The total lifetime of the
+    // dispatch metrics is in microseconds.
+    //
+    ServerLoadSample& sample = s->second;
+    sample.load.current = current;
+    if(sample.completed >= 0 && completed > sample.completed && lifetime >= sample.lifetime)
+    {
+        float latency = static_cast<float>(lifetime - sample.lifetime) / 1000.0f /
+            static_cast<float>(completed - sample.completed);
+        sample.load.latency = sample.load.latency > 0.0f ? 0.3f * latency + 0.7f * sample.load.latency : latency;
+    }
+    sample.completed = completed;
+    sample.lifetime = lifetime;
+}
+
+void
+NodeI::serverLoadFailed(const string& id)
+{
+    //
+    // The server doesn't provide the metrics view, its load is unknown.
+    //
+    IceUtil::Mutex::Lock sync(_serverLoadsMutex);
+    _serverLoads.erase(id);
+}
+
 Ice::CommunicatorPtr
 NodeI::getCommunicator() const
 {
@@ -835,6 +1043,12 @@ NodeI::getOutputDir() const
     return _outputDir;
 }
 
+string
+NodeI::getDispatchMetricsView() const
+{
+    return _dispatchMetricsView;
+}
+
 bool
 NodeI::getRedirectErrToOut() const
 {
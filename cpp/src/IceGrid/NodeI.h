@@ -16,6 +16,7 @@
 #include <IceGrid/PlatformInfo.h>
 #include <IceGrid/UserAccountMapper.h>
 #include <IceGrid/FileCache.h>
+#include <Ice/Metrics.h>
 #include <set>
 
 namespace IceGrid
@@ -123,6 +124,7 @@ public:
     const std::string& getInstanceName() const;
 
     std::string getOutputDir() const;
+    std::string getDispatchMetricsView() const;
     bool getRedirectErrToOut() const;
     bool allowEndpointsOverride() const;
     
@@ -140,6 +142,11 @@ public:
     void addServer(const ServerIPtr&, const std::string&);
     void removeServer(const ServerIPtr&, const std::string&);
 
+    void startServerLoadsCollection();
+    void collectServerLoads();
+    void serverLoadCollected(const std::string&, const IceMX::MetricsView&);
+    void serverLoadFailed(const std::string&);
+
     Ice::Identity createServerIdentity(const std::string&) const;
     std::string getServerAdminCategory() const;
 
@@ -193,6 +200,17 @@ private:
     IceUtil::Mutex _serversLock;
     std::map<std::string, std::set<ServerIPtr> > _serversByApplication;
     std::set<std::string> _patchInProgress;
+
+    struct ServerLoadSample
+    {
+        ServerLoad load;
+        Ice::Long completed;
+        Ice::Long lifetime;
+    };
+
+    const std::string _dispatchMetricsView;
+    IceUtil::Mutex _serverLoadsMutex;
+    std::map<std::string, ServerLoadSample> _serverLoads;
 };
 typedef IceUtil::Handle<NodeI> NodeIPtr;
 
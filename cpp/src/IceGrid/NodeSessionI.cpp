@@ -200,6 +200,36 @@ NodeSessionI::keepAlive(const LoadInfo& load, const Ice::Current&)
     }
 }
 
+void
+NodeSessionI::setServerLoads(const ServerLoadSeq& loads, const Ice::Current&)
+{
+    Lock sync(*this);
+    if(_destroy)
+    {
+        throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+    }
+
+    //
+    // The node sends the load of all its active servers, the load of
+    // servers which are no longer active is dropped.
+    //
+    _serverLoads.clear();
+    for(ServerLoadSeq::const_iterator p = loads.begin(); p != loads.end(); ++p)
+    {
+        _serverLoads.insert(make_pair(p->id, *p));
+    }
+
+    if(_traceLevels->node > 2)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->nodeCat);
+        out << "node `" << _info->name << "' server loads";
+        for(ServerLoadSeq::const_iterator p = loads.begin(); p != loads.end(); ++p)
+        {
+            out << "\n" << p->id << " (current = " << p->current << ", latency = " << p->latency << "ms)";
+        }
+    }
+}
+
 void
 NodeSessionI::setReplicaObserver(const ReplicaObserverPrx& observer, const Ice::Current&)
 {
@@ -347,6 +377,19 @@ NodeSessionI::getLoadInfo() const
     return _load;
 }
 
+bool
+NodeSessionI::getServerLoad(const string& id, ServerLoad& load) const
+{
+    Lock sync(*this);
+    map<string, ServerLoad>::const_iterator p = _serverLoads.find(id);
+    if(p == _serverLoads.end())
+    {
+        return false;
+    }
+    load = p->second;
+    return true;
+}
+
 NodeSessionPrx
 NodeSessionI::getProxy() const
 {
@@ -96,6 +96,8 @@ ObjectCache::add(const ObjectInfo& info, const string& application, const string
     }
     p->second.add(entry);
 
+    _proxies.put(id, entry->getProxy());
+
     if(_traceLevels && _traceLevels->object > 0)
     {
         Ice::Trace out(_traceLevels->logger, _traceLevels->objectCat);
@@ -135,6 +137,8 @@ ObjectCache::remove(const Ice::Identity& id)
         _types.erase(p);
     }
 
+    _proxies.remove(id);
+
     if(_traceLevels && _traceLevels->object > 0)
     {
         Ice::Trace out(_traceLevels->logger, _traceLevels->objectCat);
@@ -142,6 +146,12 @@ ObjectCache::remove(const Ice::Identity& id)
     }
 }
 
+Ice::ObjectPrx
+ObjectCache::getProxy(const Ice::Identity& id) const
+{
+    return _proxies.get(id);
+}
+
 vector<ObjectEntryPtr>
 ObjectCache::getObjectsByType(const string& type)
 {
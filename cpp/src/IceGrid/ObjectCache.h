@@ -13,6 +13,7 @@
 #include <IceUtil/Mutex.h>
 #include <Ice/CommunicatorF.h>
 #include <IceGrid/Cache.h>
+#include <IceGrid/SnapshotMap.h>
 #include <IceGrid/Internal.h>
 
 namespace IceGrid
@@ -51,6 +52,12 @@ public:
     ObjectEntryPtr get(const Ice::Identity&) const;
     void remove(const Ice::Identity&);
 
+    //
+    // Returns the proxy of the given object or a null proxy if the
+    // object isn't registered. This doesn't lock the cache.
+    //
+    Ice::ObjectPrx getProxy(const Ice::Identity&) const;
+
     std::vector<ObjectEntryPtr> getObjectsByType(const std::string&);
 
     ObjectInfoSeq getAll(const std::string&);
@@ -78,6 +85,7 @@ private:
 
     const Ice::CommunicatorPtr _communicator;
     std::map<std::string, TypeEntry> _types;
+    SnapshotMap<Ice::Identity, Ice::ObjectPrx> _proxies;
 
     static std::pointer_to_unary_function<int, unsigned int> _rand;
 };
@@ -403,7 +403,8 @@ RegistryI::startImpl()
 
     try
     {
-        _database = new Database(_registryAdapter, topicManager, _instanceName, _traceLevels, getInfo(), _readonly);
+        _database = new Database(_registryAdapter, topicManager, _instanceName, _traceLevels, _reaper, getInfo(),
+                                 _readonly);
     }
     catch(const IceDB::LMDBException& ex)
     {
@@ -576,6 +577,16 @@ RegistryI::startImpl()
     ObjectAdapterPtr admSessionAdpt = setupAdminSessionFactory(serverAdminRouter, nodeAdminRouter, replicaAdminRouter,
                                                                internalLocator);
 
+    //
+    // Periodically activate the replicas of the warm pools which
+    // couldn't be activated when their pool needed to be refilled.
+    //
+    WarmPoolPtr warmPool = _database->getWarmPool();
+    if(warmPool && warmPool->isEnabled())
+    {
+        _timer->scheduleRepeated(warmPool, IceUtil::Time::seconds(5));
+    }
+
     _wellKnownObjects->finish();
     if(_master)
     {
@@ -681,9 +692,11 @@ RegistryI::setupLocator(const RegistryPrx& registry, const QueryPrx& query)
 
     locatorId.name = "Locator";
     _clientAdapter->add(locator, locatorId);
+    _clientAdapter->addFacet(_database->getLocatorCacheNotifier(), locatorId, "LocatorCache");
 
     locatorId.name = "Locator-" + _replicaName;
     _clientAdapter->add(locator, locatorId);
+    _clientAdapter->addFacet(_database->getLocatorCacheNotifier(), locatorId, "LocatorCache");
 
     return LocatorPrx::uncheckedCast(_registryAdapter->addWithUUID(locator));
 }
@@ -28,6 +28,25 @@ operator==(const ObjectInfo& info, const Ice::Identity& id)
 
 }
 
+namespace
+{
+
+Ice::Long
+getSlaveSerial(const IceUtil::Optional<StringLongDict>& serials, const string& dbName)
+{
+    if(serials)
+    {
+        StringLongDict::const_iterator p = serials->find(dbName);
+        if(p != serials->end())
+        {
+            return p->second;
+        }
+    }
+    return -1;
+}
+
+}
+
 ReplicaSessionI::ReplicaSessionI(const DatabasePtr& database,
                                  const WellKnownObjectsManagerPtr& wellKnownObjects,
                                  const InternalReplicaInfoPtr& info,
@@ -147,6 +166,14 @@ ReplicaSessionI::setDatabaseObserver(const DatabaseObserverPrx& observer,
         }
     }
 
+    //
+    // The slave only receives the updates it missed if the master still
+    // logs them, it receives the master database otherwise.
+    //
+    Ice::Long applicationsSerial = getSlaveSerial(slaveSerials, "applications");
+    Ice::Long adaptersSerial = getSlaveSerial(slaveSerials, "adapters");
+    Ice::Long objectsSerial = getSlaveSerial(slaveSerials, "objects");
+
     int serialApplicationObserver;
     int serialAdapterObserver;
     int serialObjectObserver;
@@ -163,9 +190,9 @@ ReplicaSessionI::setDatabaseObserver(const DatabaseObserverPrx& observer,
         }
         _observer = observer;
 
-        serialApplicationObserver = applicationObserver->subscribe(_observer, _info->name);
-        serialAdapterObserver = adapterObserver->subscribe(_observer, _info->name);
-        serialObjectObserver = objectObserver->subscribe(_observer, _info->name);
+        serialApplicationObserver = applicationObserver->subscribe(_observer, _info->name, applicationsSerial);
+        serialAdapterObserver = adapterObserver->subscribe(_observer, _info->name, adaptersSerial);
+        serialObjectObserver = objectObserver->subscribe(_observer, _info->name, objectsSerial);
     }
 
     applicationObserver->waitForSyncedSubscribers(serialApplicationObserver, _info->name);
@@ -36,6 +36,7 @@ public:
     applicationInit(int, const ApplicationInfoSeq& applications, const Ice::Current& current)
     {
         int serial;
+        traceInit("applications", applications.size());
         _database->syncApplications(applications, getSerials(current.ctx, serial));
         receivedUpdate(ApplicationObserverTopicName, serial);
     }
@@ -104,6 +105,7 @@ public:
     adapterInit(const AdapterInfoSeq& adapters, const Ice::Current& current)
     {
         int serial;
+        traceInit("adapters", adapters.size());
         _database->syncAdapters(adapters, getSerials(current.ctx, serial));
         receivedUpdate(AdapterObserverTopicName, serial);
     }
@@ -160,6 +162,7 @@ public:
     objectInit(const ObjectInfoSeq& objects, const Ice::Current& current)
     {
         int serial;
+        traceInit("objects", objects.size());
         _database->syncObjects(objects, getSerials(current.ctx, serial));
         receivedUpdate(ObjectObserverTopicName, serial);
     }
@@ -259,6 +262,21 @@ private:
         }
     }
     
+    void
+    traceInit(const string& name, size_t count)
+    {
+        //
+        // The master only sends the whole content of a database table if
+        // the updates missed by this replica are no longer logged.
+        //
+        TraceLevelsPtr traceLevels = _database->getTraceLevels();
+        if(traceLevels->replica > 0)
+        {
+            Ice::Trace out(traceLevels->logger, traceLevels->replicaCat);
+            out << "initializing database with " << count << " " << name << " from master replica";
+        }
+    }
+
     void 
     receivedUpdate(TopicName name, int serial, const string& failure = string())
     {
@@ -667,6 +667,40 @@ ServerEntry::getLoad(LoadSample sample) const
     }
 }
 
+float
+ServerEntry::getDispatchLoad() const
+{
+    string node;
+    {
+        Lock sync(*this);
+        if(_loaded.get())
+        {
+            node = _loaded->node;
+        }
+        else if(_load.get())
+        {
+            node = _load->node;
+        }
+        else
+        {
+            throw ServerNotExistException();
+        }
+    }
+
+    //
+    // The dispatch load is an estimate of the time to dispatch a new
+    // request: the number of requests being dispatched, plus the new
+    // one, times the average dispatch latency. It's -1 if the node
+    // didn't provide the load of the server.
+    //
+    ServerLoad load;
+    if(!_cache.getNodeCache().get(node)->getServerLoad(_id, load))
+    {
+        return -1.0f;
+    }
+    return static_cast<float>(load.current + 1) * max(load.latency, 0.001f);
+}
+
 void
 ServerEntry::syncImpl()
 {
@@ -3255,5 +3255,30 @@ ServerI::getProperties(const InternalServerDescriptorPtr& desc)
         }
     }
 
+    //
+    // The node collects the dispatch load from the server metrics view
+    // with a request on the server admin adapter. Reject the dispatch
+    // of the admin adapter from the view so that the collection isn't
+    // counted in the load, unless the server already rejects it.
+    //
+    string view = _node->getDispatchMetricsView();
+    if(!view.empty())
+    {
+        string viewPrefix = "IceMX.Metrics." + view + ".";
+        string mapPrefix = viewPrefix + "Map.Dispatch.";
+        bool hasView = false;
+        bool hasMap = false;
+        for(PropertyDescriptorSeq::const_iterator p = props.begin(); p != props.end(); ++p)
+        {
+            hasView = hasView || p->name.compare(0, viewPrefix.size(), viewPrefix) == 0;
+            hasMap = hasMap || p->name.compare(0, mapPrefix.size(), mapPrefix) == 0;
+        }
+        string prefix = hasMap ? mapPrefix : viewPrefix;
+        if(hasView && getProperty(props, prefix + "Reject.parent").empty())
+        {
+            props.push_back(createProperty(prefix + "Reject.parent", "Ice\\.Admin"));
+        }
+    }
+
     return properties;
 }
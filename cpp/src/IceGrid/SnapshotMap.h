@@ -0,0 +1,129 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_GRID_SNAPSHOT_MAP_H
+#define ICE_GRID_SNAPSHOT_MAP_H
+
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <map>
+
+namespace IceGrid
+{
+
+//
+// A map which is read from an immutable snapshot. Updates copy the
+// current snapshot, modify the copy and replace the snapshot with it,
+// readers are never blocked by an update. The mutex only protects the
+// snapshot handle, it's held while the handle is copied or replaced.
+//
+// Updates must be serialized by the caller.
+//
+template<typename Key, typename Value>
+class SnapshotMap
+{
+public:
+
+    typedef std::map<Key, Value> Map;
+
+    SnapshotMap() : _snapshot(new Snapshot)
+    {
+    }
+
+    //
+    // Returns the value of the given key or a default constructed
+    // value if the key isn't in the map.
+    //
+    Value
+    get(const Key& key) const
+    {
+        SnapshotPtr snapshot = getSnapshot();
+        typename Map::const_iterator p = snapshot->map.find(key);
+        return p != snapshot->map.end() ? p->second : Value();
+    }
+
+    void
+    put(const Key& key, const Value& value)
+    {
+        SnapshotPtr snapshot = new Snapshot(_snapshot->map); // _snapshot is only replaced by the caller.
+        snapshot->map[key] = value;
+        setSnapshot(snapshot);
+    }
+
+    void
+    remove(const Key& key)
+    {
+        if(_snapshot->map.find(key) == _snapshot->map.end())
+        {
+            return;
+        }
+        SnapshotPtr snapshot = new Snapshot(_snapshot->map);
+        snapshot->map.erase(key);
+        setSnapshot(snapshot);
+    }
+
+    //
+    // Returns a copy of the map. Several updates are applied to the copy
+    // and published with a single reset.
+    //
+    Map
+    copy() const
+    {
+        return getSnapshot()->map;
+    }
+
+    void
+    reset(const Map& map)
+    {
+        setSnapshot(new Snapshot(map));
+    }
+
+private:
+
+    struct Snapshot : public IceUtil::Shared
+    {
+        Snapshot()
+        {
+        }
+
+        Snapshot(const Map& m) : map(m)
+        {
+        }
+
+        Map map;
+    };
+    typedef IceUtil::Handle<Snapshot> SnapshotPtr;
+
+    SnapshotPtr
+    getSnapshot() const
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        return _snapshot;
+    }
+
+    void
+    setSnapshot(const SnapshotPtr& snapshot)
+    {
+        SnapshotPtr old;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            old = _snapshot;
+            _snapshot = snapshot;
+        }
+        // The old snapshot is released outside the lock.
+    }
+
+    mutable IceUtil::Mutex _mutex;
+    SnapshotPtr _snapshot;
+};
+
+}
+
+#endif
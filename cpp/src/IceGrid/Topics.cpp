@@ -30,7 +30,20 @@ Ice::EncodingVersion encodings[] = {
 }
 
 ObserverTopic::ObserverTopic(const IceStorm::TopicManagerPrx& topicManager, const string& name, Ice::Long dbSerial) :
-    _logger(topicManager->ice_getCommunicator()->getLogger()), _serial(0), _dbSerial(dbSerial)
+    _logger(topicManager->ice_getCommunicator()->getLogger()),
+    _serial(0),
+    _dbSerial(dbSerial),
+    _logSize(static_cast<size_t>(max(0, topicManager->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                                              "IceGrid.Registry.ReplicationLogSize", 1000)))),
+    _logSizeMax(static_cast<size_t>(max(0, topicManager->ice_getCommunicator()->getProperties()->
+                                           getPropertyAsIntWithDefault("IceGrid.Registry.ReplicationLogSizeMax",
+                                                                       10240))) * 1024),
+    _logBytes(0),
+    _logStart(dbSerial),
+    _pageSize(static_cast<size_t>(max(0, topicManager->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                                               "IceGrid.Registry.ObserverPageSize", 1000)))),
+    _sendQueueSizeMax(topicManager->ice_getCommunicator()->getProperties()->getPropertyAsInt(
+                          "IceGrid.Registry.ObserverQueueSizeMax"))
 {
     for(int i = 0; i < static_cast<int>(sizeof(encodings) / sizeof(Ice::EncodingVersion)); ++i)
     {
@@ -61,7 +74,7 @@ ObserverTopic::~ObserverTopic()
 }
 
 int
-ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
+ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name, Ice::Long dbSerial)
 {
     Lock sync(*this);
     if(_topics.empty())
@@ -70,10 +83,24 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
     }
 
     assert(obsv);
+    int lastSerial;
+    bool synced;
     try
     {
         IceStorm::QoS qos;
         qos["reliability"] = "ordered";
+        if(name.empty() && _sendQueueSizeMax > 0)
+        {
+            //
+            // Admin observers which don't keep up with the updates are
+            // unsubscribed instead of queuing an unlimited number of
+            // updates. They can subscribe again with the database serial
+            // of their last update to get the updates they missed.
+            //
+            ostringstream os;
+            os << _sendQueueSizeMax;
+            qos["sendQueueSizeMax"] = os.str();
+        }
         Ice::EncodingVersion v = IceInternal::getCompatibleEncoding(obsv->ice_getEncodingVersion());
         map<Ice::EncodingVersion, IceStorm::TopicPrx>::const_iterator p = _topics.find(v);
         if(p == _topics.end())
@@ -82,7 +109,25 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
             out << "unsupported encoding version for observer `" << obsv << "'";
             return -1;
         }
-        initObserver(p->second->subscribeAndGetPublisher(qos, obsv->ice_twoway()));
+        Ice::ObjectPrx publisher = p->second->subscribeAndGetPublisher(qos, obsv->ice_twoway());
+
+        //
+        // If the subscriber provides the serial of its database, only
+        // send the updates it missed if they are still logged. A
+        // subscriber which is already up to date doesn't receive any
+        // call, not even the init call.
+        //
+        lastSerial = dbSerial >= 0 ? sendLoggedUpdates(publisher, dbSerial) : -1;
+        synced = lastSerial == 0;
+        if(lastSerial < 0)
+        {
+            //
+            // Replicas must receive their initial state with a single
+            // init call, their database is replaced with its content.
+            //
+            initObserver(publisher, name.empty() ? _pageSize : 0);
+            lastSerial = _serial;
+        }
     }
     catch(const IceStorm::AlreadySubscribed&)
     {
@@ -93,12 +138,21 @@ ObserverTopic::subscribe(const Ice::ObjectPrx& obsv, const string& name)
     {
         assert(_syncSubscribers.find(name) == _syncSubscribers.end());
         _syncSubscribers.insert(name);
-        addExpectedUpdate(_serial, name);
-        return _serial;
+        if(!synced)
+        {
+            addExpectedUpdate(lastSerial, name);
+            return lastSerial;
+        }
     }
     return -1;
 }
 
+int
+ObserverTopic::sendLoggedUpdates(const Ice::ObjectPrx&, Ice::Long)
+{
+    return -1;
+}
+
 void
 ObserverTopic::unsubscribe(const Ice::ObjectPrx& observer, const string& name)
 {
@@ -349,7 +403,7 @@ RegistryObserverTopic::registryDown(const string& name)
 }
 
 void
-RegistryObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
+RegistryObserverTopic::initObserver(const Ice::ObjectPrx& obsv, size_t)
 {
     RegistryObserverPrx observer = RegistryObserverPrx::uncheckedCast(obsv);
     RegistryInfoSeq registries;
@@ -362,8 +416,12 @@ RegistryObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
 }
 
 NodeObserverTopic::NodeObserverTopic(const IceStorm::TopicManagerPrx& topicManager,
-                                     const Ice::ObjectAdapterPtr& adapter) :
-    ObserverTopic(topicManager, "NodeObserver")
+                                     const Ice::ObjectAdapterPtr& adapter,
+                                     const LocatorCacheNotifierIPtr& locatorCacheNotifier,
+                                     const WarmPoolPtr& warmPool) :
+    ObserverTopic(topicManager, "NodeObserver"),
+    _locatorCacheNotifier(locatorCacheNotifier),
+    _warmPool(warmPool)
 {
     _publishers = getPublishers<NodeObserverPrx>();
     try
@@ -384,28 +442,39 @@ NodeObserverTopic::nodeInit(const NodeDynamicInfoSeq&, const Ice::Current&)
 void
 NodeObserverTopic::nodeUp(const NodeDynamicInfo& info, const Ice::Current&)
 {
-    Lock sync(*this);
-    if(_topics.empty())
-    {
-        return;
-    }
-    updateSerial();
-    _nodes.insert(make_pair(info.info.name, info));
-    for(ServerDynamicInfoSeq::const_iterator p = info.servers.begin(); p != info.servers.end(); ++p)
     {
-        _serverStatus[p->id] = p->enabled;
-    }
-    try
-    {
-        for(vector<NodeObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
+        Lock sync(*this);
+        if(_topics.empty())
+        {
+            return;
+        }
+        updateSerial();
+        _nodes.insert(make_pair(info.info.name, info));
+        for(ServerDynamicInfoSeq::const_iterator p = info.servers.begin(); p != info.servers.end(); ++p)
+        {
+            _serverStatus[p->id] = p->enabled;
+        }
+        try
+        {
+            for(vector<NodeObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
+            {
+                (*p)->nodeUp(info);
+            }
+        }
+        catch(const Ice::LocalException& ex)
         {
-            (*p)->nodeUp(info);
+            Ice::Warning out(_logger);
+            out << "unexpected exception while publishing 'nodeUp' update:\n" << ex;
         }
     }
-    catch(const Ice::LocalException& ex)
+
+    //
+    // Called once the enabled state of the node servers is known, the
+    // warm pool doesn't activate the disabled replicas.
+    //
+    if(_warmPool)
     {
-        Ice::Warning out(_logger);
-        out << "unexpected exception while publishing 'nodeUp' update:\n" << ex;
+        _warmPool->nodeUp(info);
     }
 }
 
@@ -483,6 +552,17 @@ NodeObserverTopic::updateServer(const string& node, const ServerDynamicInfo& ser
 void
 NodeObserverTopic::updateAdapter(const string& node, const AdapterDynamicInfo& adapter, const Ice::Current&)
 {
+    //
+    // The endpoints of the server adapter changed, clients which cached
+    // them must look them up again.
+    //
+    _locatorCacheNotifier->serverAdapterChanged(adapter.id);
+
+    if(_warmPool)
+    {
+        _warmPool->adapterChanged(adapter);
+    }
+
     Lock sync(*this);
     if(_topics.empty())
     {
@@ -558,6 +638,11 @@ NodeObserverTopic::nodeDown(const string& name)
         _serverStatus.erase(p->id);
     }
 
+    if(_warmPool)
+    {
+        _warmPool->nodeDown(_nodes[name]);
+    }
+
     _nodes.erase(name);
     try
     {
@@ -574,16 +659,21 @@ NodeObserverTopic::nodeDown(const string& name)
 }
 
 void
-NodeObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
+NodeObserverTopic::initObserver(const Ice::ObjectPrx& obsv, size_t pageSize)
 {
     NodeObserverPrx observer = NodeObserverPrx::uncheckedCast(obsv);
     NodeDynamicInfoSeq nodes;
-    nodes.reserve(_nodes.size());
-    for(map<string, NodeDynamicInfo>::const_iterator p = _nodes.begin(); p != _nodes.end(); ++p)
+    map<string, NodeDynamicInfo>::const_iterator p = _nodes.begin();
+    for(; p != _nodes.end() && (pageSize == 0 || nodes.size() < pageSize); ++p)
     {
         nodes.push_back(p->second);
     }
-    observer->nodeInit(nodes, getContext(_serial));
+    const Ice::Context context = getContext(_serial);
+    observer->nodeInit(nodes, context);
+    for(; p != _nodes.end(); ++p)
+    {
+        observer->nodeUp(p->second, context);
+    }
 }
 
 bool
@@ -608,6 +698,7 @@ NodeObserverTopic::isServerEnabled(const string& server) const
 ApplicationObserverTopic::ApplicationObserverTopic(const IceStorm::TopicManagerPrx& topicManager,
                                                    const map<string, ApplicationInfo>& applications, Ice::Long serial) :
     ObserverTopic(topicManager, "ApplicationObserver", serial),
+    _communicator(topicManager->ice_getCommunicator()),
     _applications(applications)
 {
     _publishers = getPublishers<ApplicationObserverPrx>();
@@ -627,6 +718,7 @@ ApplicationObserverTopic::applicationInit(Ice::Long dbSerial, const ApplicationI
     {
         _applications.insert(make_pair(p->descriptor.name, *p));
     }
+    resetLog(_updates);
     try
     {
         for(vector<ApplicationObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -654,6 +746,7 @@ ApplicationObserverTopic::applicationAdded(Ice::Long dbSerial, const Application
 
     updateSerial(dbSerial);
     _applications.insert(make_pair(info.descriptor.name, info));
+    logApplicationUpdate(Added, info, ApplicationUpdateInfo(), dbSerial);
     try
     {
         for(vector<ApplicationObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -680,6 +773,11 @@ ApplicationObserverTopic::applicationRemoved(Ice::Long dbSerial, const string& n
     }
     updateSerial(dbSerial);
     _applications.erase(name);
+    {
+        ApplicationInfo info;
+        info.descriptor.name = name;
+        logApplicationUpdate(Removed, info, ApplicationUpdateInfo(), dbSerial);
+    }
     try
     {
         for(vector<ApplicationObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -742,6 +840,7 @@ ApplicationObserverTopic::applicationUpdated(Ice::Long dbSerial, const Applicati
         out << "unexpected exception while instantiating application `" << info.descriptor.name << "'";
         assert(false);
     }
+    logApplicationUpdate(Updated, ApplicationInfo(), info, dbSerial);
     try
     {
         for(vector<ApplicationObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -759,8 +858,12 @@ ApplicationObserverTopic::applicationUpdated(Ice::Long dbSerial, const Applicati
 }
 
 void
-ApplicationObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
+ApplicationObserverTopic::initObserver(const Ice::ObjectPrx& obsv, size_t)
 {
+    //
+    // The applications are always sent with the init call, observers
+    // expect each applicationAdded call to increment the serial.
+    //
     ApplicationObserverPrx observer = ApplicationObserverPrx::uncheckedCast(obsv);
     ApplicationInfoSeq applications;
     for(map<string, ApplicationInfo>::const_iterator p = _applications.begin(); p != _applications.end(); ++p)
@@ -770,6 +873,60 @@ ApplicationObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
     observer->applicationInit(_serial, applications, getContext(_serial, _dbSerial));
 }
 
+int
+ApplicationObserverTopic::sendLoggedUpdates(const Ice::ObjectPrx& obsv, Ice::Long dbSerial)
+{
+    if(dbSerial < _logStart)
+    {
+        return -1;
+    }
+
+    ApplicationObserverPrx observer = ApplicationObserverPrx::uncheckedCast(obsv);
+    int serial = 0;
+    for(deque<ApplicationUpdate>::const_iterator p = _updates.begin(); p != _updates.end(); ++p)
+    {
+        if(!isLogged(*p, dbSerial))
+        {
+            continue;
+        }
+
+        Ice::Context context = getContext(p->serial, p->serialized ? p->dbSerial : 0);
+        switch(p->kind)
+        {
+        case Added:
+            observer->applicationAdded(p->serial, p->info, context);
+            break;
+        case Updated:
+            observer->applicationUpdated(p->serial, p->update, context);
+            break;
+        case Removed:
+            observer->applicationRemoved(p->serial, p->info.descriptor.name, context);
+            break;
+        }
+        serial = p->serial;
+    }
+    return serial;
+}
+
+void
+ApplicationObserverTopic::logApplicationUpdate(UpdateKind kind, const ApplicationInfo& info,
+                                               const ApplicationUpdateInfo& update, Ice::Long dbSerial)
+{
+    ApplicationUpdate u;
+    u.kind = kind;
+    u.info = info;
+    u.update = update;
+
+    //
+    // The descriptors of an application can be large, the log is also
+    // bounded by the marshaled size of the updates.
+    //
+    Ice::OutputStream out(_communicator);
+    out.write(info);
+    out.write(update);
+    logUpdate(_updates, u, dbSerial, out.b.size());
+}
+
 AdapterObserverTopic::AdapterObserverTopic(const IceStorm::TopicManagerPrx& topicManager,
                                            const map<string, AdapterInfo>& adapters, Ice::Long serial) :
     ObserverTopic(topicManager, "AdapterObserver", serial),
@@ -792,6 +949,7 @@ AdapterObserverTopic::adapterInit(Ice::Long dbSerial, const AdapterInfoSeq& adpt
     {
         _adapters.insert(make_pair(q->id, *q));
     }
+    resetLog(_updates);
     try
     {
         for(vector<AdapterObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -818,6 +976,7 @@ AdapterObserverTopic::adapterAdded(Ice::Long dbSerial, const AdapterInfo& info)
     }
     updateSerial(dbSerial);
     _adapters.insert(make_pair(info.id, info));
+    logAdapterUpdate(Added, info, dbSerial);
     try
     {
         for(vector<AdapterObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -844,6 +1003,7 @@ AdapterObserverTopic::adapterUpdated(Ice::Long dbSerial, const AdapterInfo& info
     }
     updateSerial(dbSerial);
     _adapters[info.id] = info;
+    logAdapterUpdate(Updated, info, dbSerial);
     try
     {
         for(vector<AdapterObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -870,6 +1030,11 @@ AdapterObserverTopic::adapterRemoved(Ice::Long dbSerial, const string& id)
     }
     updateSerial(dbSerial);
     _adapters.erase(id);
+    {
+        AdapterInfo info;
+        info.id = id;
+        logAdapterUpdate(Removed, info, dbSerial);
+    }
     try
     {
         for(vector<AdapterObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -887,15 +1052,65 @@ AdapterObserverTopic::adapterRemoved(Ice::Long dbSerial, const string& id)
 }
 
 void
-AdapterObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
+AdapterObserverTopic::initObserver(const Ice::ObjectPrx& obsv, size_t pageSize)
 {
     AdapterObserverPrx observer = AdapterObserverPrx::uncheckedCast(obsv);
     AdapterInfoSeq adapters;
-    for(map<string, AdapterInfo>::const_iterator p = _adapters.begin(); p != _adapters.end(); ++p)
+    map<string, AdapterInfo>::const_iterator p = _adapters.begin();
+    for(; p != _adapters.end() && (pageSize == 0 || adapters.size() < pageSize); ++p)
     {
         adapters.push_back(p->second);
     }
-    observer->adapterInit(adapters, getContext(_serial, _dbSerial));
+    const Ice::Context context = getContext(_serial, _dbSerial);
+    observer->adapterInit(adapters, context);
+    for(; p != _adapters.end(); ++p)
+    {
+        observer->adapterAdded(p->second, context);
+    }
+}
+
+int
+AdapterObserverTopic::sendLoggedUpdates(const Ice::ObjectPrx& obsv, Ice::Long dbSerial)
+{
+    if(dbSerial < _logStart)
+    {
+        return -1;
+    }
+
+    AdapterObserverPrx observer = AdapterObserverPrx::uncheckedCast(obsv);
+    int serial = 0;
+    for(deque<AdapterUpdate>::const_iterator p = _updates.begin(); p != _updates.end(); ++p)
+    {
+        if(!isLogged(*p, dbSerial))
+        {
+            continue;
+        }
+
+        Ice::Context context = getContext(p->serial, p->serialized ? p->dbSerial : 0);
+        switch(p->kind)
+        {
+        case Added:
+            observer->adapterAdded(p->info, context);
+            break;
+        case Updated:
+            observer->adapterUpdated(p->info, context);
+            break;
+        case Removed:
+            observer->adapterRemoved(p->info.id, context);
+            break;
+        }
+        serial = p->serial;
+    }
+    return serial;
+}
+
+void
+AdapterObserverTopic::logAdapterUpdate(UpdateKind kind, const AdapterInfo& info, Ice::Long dbSerial)
+{
+    AdapterUpdate u;
+    u.kind = kind;
+    u.info = info;
+    logUpdate(_updates, u, dbSerial);
 }
 
 ObjectObserverTopic::ObjectObserverTopic(const IceStorm::TopicManagerPrx& topicManager,
@@ -920,6 +1135,7 @@ ObjectObserverTopic::objectInit(Ice::Long dbSerial, const ObjectInfoSeq& objects
     {
         _objects.insert(make_pair(r->proxy->ice_getIdentity(), *r));
     }
+    resetLog(_updates);
     try
     {
         for(vector<ObjectObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -946,6 +1162,7 @@ ObjectObserverTopic::objectAdded(Ice::Long dbSerial, const ObjectInfo& info)
     }
     updateSerial(dbSerial);
     _objects.insert(make_pair(info.proxy->ice_getIdentity(), info));
+    logObjectUpdate(Added, info, info.proxy->ice_getIdentity(), dbSerial);
     try
     {
         for(vector<ObjectObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -972,6 +1189,7 @@ ObjectObserverTopic::objectUpdated(Ice::Long dbSerial, const ObjectInfo& info)
     }
     updateSerial(dbSerial);
     _objects[info.proxy->ice_getIdentity()] = info;
+    logObjectUpdate(Updated, info, info.proxy->ice_getIdentity(), dbSerial);
     try
     {
         for(vector<ObjectObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -998,6 +1216,7 @@ ObjectObserverTopic::objectRemoved(Ice::Long dbSerial, const Ice::Identity& id)
     }
     updateSerial(dbSerial);
     _objects.erase(id);
+    logObjectUpdate(Removed, ObjectInfo(), id, dbSerial);
     try
     {
         for(vector<ObjectObserverPrx>::const_iterator p = _publishers.begin(); p != _publishers.end(); ++p)
@@ -1030,6 +1249,7 @@ ObjectObserverTopic::wellKnownObjectsAddedOrUpdated(const ObjectInfoSeq& infos)
         if(q != _objects.end())
         {
             q->second = *p;
+            logObjectUpdate(Updated, *p, p->proxy->ice_getIdentity(), 0);
             try
             {
                 for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -1046,6 +1266,7 @@ ObjectObserverTopic::wellKnownObjectsAddedOrUpdated(const ObjectInfoSeq& infos)
         else
         {
             _objects.insert(make_pair(p->proxy->ice_getIdentity(), *p));
+            logObjectUpdate(Added, *p, p->proxy->ice_getIdentity(), 0);
             try
             {
                 for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -1083,6 +1304,7 @@ ObjectObserverTopic::wellKnownObjectsRemoved(const ObjectInfoSeq& infos)
     {
         updateSerial();
         _objects.erase(p->proxy->ice_getIdentity());
+        logObjectUpdate(Removed, ObjectInfo(), p->proxy->ice_getIdentity(), 0);
         try
         {
             for(vector<ObjectObserverPrx>::const_iterator q = _publishers.begin(); q != _publishers.end(); ++q)
@@ -1108,13 +1330,65 @@ ObjectObserverTopic::wellKnownObjectsRemoved(const ObjectInfoSeq& infos)
 }
 
 void
-ObjectObserverTopic::initObserver(const Ice::ObjectPrx& obsv)
+ObjectObserverTopic::initObserver(const Ice::ObjectPrx& obsv, size_t pageSize)
 {
     ObjectObserverPrx observer = ObjectObserverPrx::uncheckedCast(obsv);
     ObjectInfoSeq objects;
-    for(map<Ice::Identity, ObjectInfo>::const_iterator p = _objects.begin(); p != _objects.end(); ++p)
+    map<Ice::Identity, ObjectInfo>::const_iterator p = _objects.begin();
+    for(; p != _objects.end() && (pageSize == 0 || objects.size() < pageSize); ++p)
     {
         objects.push_back(p->second);
     }
-    observer->objectInit(objects, getContext(_serial, _dbSerial));
+    const Ice::Context context = getContext(_serial, _dbSerial);
+    observer->objectInit(objects, context);
+    for(; p != _objects.end(); ++p)
+    {
+        observer->objectAdded(p->second, context);
+    }
+}
+
+int
+ObjectObserverTopic::sendLoggedUpdates(const Ice::ObjectPrx& obsv, Ice::Long dbSerial)
+{
+    if(dbSerial < _logStart)
+    {
+        return -1;
+    }
+
+    ObjectObserverPrx observer = ObjectObserverPrx::uncheckedCast(obsv);
+    int serial = 0;
+    for(deque<ObjectUpdate>::const_iterator p = _updates.begin(); p != _updates.end(); ++p)
+    {
+        if(!isLogged(*p, dbSerial))
+        {
+            continue;
+        }
+
+        Ice::Context context = getContext(p->serial, p->serialized ? p->dbSerial : 0);
+        switch(p->kind)
+        {
+        case Added:
+            observer->objectAdded(p->info, context);
+            break;
+        case Updated:
+            observer->objectUpdated(p->info, context);
+            break;
+        case Removed:
+            observer->objectRemoved(p->id, context);
+            break;
+        }
+        serial = p->serial;
+    }
+    return serial;
+}
+
+void
+ObjectObserverTopic::logObjectUpdate(UpdateKind kind, const ObjectInfo& info, const Ice::Identity& id,
+                                     Ice::Long dbSerial)
+{
+    ObjectUpdate u;
+    u.kind = kind;
+    u.info = info;
+    u.id = id;
+    logUpdate(_updates, u, dbSerial);
 }
@@ -14,7 +14,10 @@
 #include <IceStorm/IceStorm.h>
 #include <IceGrid/Internal.h>
 #include <IceGrid/Registry.h>
+#include <IceGrid/LocatorCacheNotifierI.h>
+#include <IceGrid/WarmPool.h>
 #include <set>
+#include <deque>
 
 namespace IceGrid
 {
@@ -26,13 +29,26 @@ public:
     ObserverTopic(const IceStorm::TopicManagerPrx&, const std::string&, Ice::Long = 0);
     virtual ~ObserverTopic();
 
-    int subscribe(const Ice::ObjectPrx&, const std::string& = std::string());
+    int subscribe(const Ice::ObjectPrx&, const std::string& = std::string(), Ice::Long = -1);
     void unsubscribe(const Ice::ObjectPrx&, const std::string& = std::string());
     void destroy();
 
     void receivedUpdate(const std::string&, int, const std::string&);
 
-    virtual void initObserver(const Ice::ObjectPrx&) = 0;
+    //
+    // Send the current state to the given observer. If the page size
+    // isn't 0, the init call only carries the first page of the state
+    // and the remaining items are sent as individual updates.
+    //
+    virtual void initObserver(const Ice::ObjectPrx&, size_t) = 0;
+
+    //
+    // Send the logged updates which follow the given database serial
+    // with the serial they were published with. Returns the serial of
+    // the last update sent, 0 if there's no update to send or -1 if
+    // these updates are no longer logged.
+    //
+    virtual int sendLoggedUpdates(const Ice::ObjectPrx&, Ice::Long);
 
     void waitForSyncedSubscribers(int, const std::string& = std::string());
 
@@ -45,6 +61,53 @@ protected:
     void updateSerial(Ice::Long = 0);
     Ice::Context getContext(int, Ice::Long = 0) const;
 
+    enum UpdateKind
+    {
+        Added,
+        Updated,
+        Removed
+    };
+
+    //
+    // Updates without a database serial (registry well-known objects)
+    // are logged with the serial of the last update. The log is bounded
+    // by its number of updates and by the size of the updates, the size
+    // is only given for the updates whose size isn't small and bounded
+    // (application descriptors).
+    //
+    template<typename T> void logUpdate(std::deque<T>& log, T update, Ice::Long dbSerial, size_t size = 0)
+    {
+        update.serial = _serial;
+        update.serialized = dbSerial > 0;
+        update.dbSerial = update.serialized ? dbSerial : _dbSerial;
+        update.size = size;
+        log.push_back(update);
+        _logBytes += size;
+        while(!log.empty() && (log.size() > _logSize || _logBytes > _logSizeMax))
+        {
+            //
+            // Subscribers which haven't received the removed update
+            // can't be synchronized with the log anymore.
+            //
+            const T& first = log.front();
+            _logStart = std::max(_logStart, first.serialized ? first.dbSerial : first.dbSerial + 1);
+            _logBytes -= first.size;
+            log.pop_front();
+        }
+    }
+
+    template<typename T> void resetLog(std::deque<T>& log)
+    {
+        log.clear();
+        _logBytes = 0;
+        _logStart = _dbSerial;
+    }
+
+    template<typename T> bool isLogged(const T& update, Ice::Long dbSerial) const
+    {
+        return update.serialized ? update.dbSerial > dbSerial : update.dbSerial >= dbSerial;
+    }
+
     template<typename T> std::vector<T> getPublishers() const
     {
         std::vector<T> publishers;
@@ -60,6 +123,12 @@ protected:
     std::vector<Ice::ObjectPrx> _basePublishers;
     int _serial;
     Ice::Long _dbSerial;
+    const size_t _logSize;
+    const size_t _logSizeMax; // The maximum size in bytes of the logged updates.
+    size_t _logBytes;
+    Ice::Long _logStart; // The updates after this database serial are logged.
+    const size_t _pageSize; // The maximum number of items sent to admin observers with the init call.
+    const int _sendQueueSizeMax; // The maximum number of updates queued for an admin observer.
 
     std::set<std::string> _syncSubscribers;
     std::map<int, std::set<std::string> > _waitForUpdates;
@@ -76,7 +145,7 @@ public:
     void registryUp(const RegistryInfo&);
     void registryDown(const std::string&);
 
-    virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void initObserver(const Ice::ObjectPrx&, size_t);
 
 private:
 
@@ -89,7 +158,8 @@ class NodeObserverTopic : public ObserverTopic, public NodeObserver
 {
 public:
 
-    NodeObserverTopic(const IceStorm::TopicManagerPrx&, const Ice::ObjectAdapterPtr&);
+    NodeObserverTopic(const IceStorm::TopicManagerPrx&, const Ice::ObjectAdapterPtr&,
+                      const LocatorCacheNotifierIPtr&, const WarmPoolPtr&);
 
     virtual void nodeInit(const NodeDynamicInfoSeq&, const Ice::Current&);
     virtual void nodeUp(const NodeDynamicInfo&, const Ice::Current&);
@@ -100,13 +170,15 @@ public:
     const NodeObserverPrx& getPublisher() { return _externalPublisher; }
 
     void nodeDown(const std::string&);
-    virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void initObserver(const Ice::ObjectPrx&, size_t);
 
     bool isServerEnabled(const std::string&) const;
 
 private:
 
     const NodeObserverPrx _externalPublisher;
+    const LocatorCacheNotifierIPtr _locatorCacheNotifier;
+    const WarmPoolPtr _warmPool;
     std::vector<NodeObserverPrx> _publishers;
     std::map<std::string, NodeDynamicInfo> _nodes;
     std::map<std::string, bool> _serverStatus;
@@ -124,12 +196,28 @@ public:
     int applicationRemoved(Ice::Long, const std::string&);
     int applicationUpdated(Ice::Long, const ApplicationUpdateInfo&);
 
-    virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void initObserver(const Ice::ObjectPrx&, size_t);
+    virtual int sendLoggedUpdates(const Ice::ObjectPrx&, Ice::Long);
 
 private:
 
+    struct ApplicationUpdate
+    {
+        UpdateKind kind;
+        ApplicationInfo info;
+        ApplicationUpdateInfo update;
+        int serial;
+        Ice::Long dbSerial;
+        bool serialized;
+        size_t size;
+    };
+
+    void logApplicationUpdate(UpdateKind, const ApplicationInfo&, const ApplicationUpdateInfo&, Ice::Long);
+
+    const Ice::CommunicatorPtr _communicator;
     std::vector<ApplicationObserverPrx> _publishers;
     std::map<std::string, ApplicationInfo> _applications;
+    std::deque<ApplicationUpdate> _updates;
 };
 typedef IceUtil::Handle<ApplicationObserverTopic> ApplicationObserverTopicPtr;
 
@@ -144,12 +232,26 @@ public:
     int adapterUpdated(Ice::Long, const AdapterInfo&);
     int adapterRemoved(Ice::Long, const std::string&);
 
-    virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void initObserver(const Ice::ObjectPrx&, size_t);
+    virtual int sendLoggedUpdates(const Ice::ObjectPrx&, Ice::Long);
 
 private:
 
+    struct AdapterUpdate
+    {
+        UpdateKind kind;
+        AdapterInfo info;
+        int serial;
+        Ice::Long dbSerial;
+        bool serialized;
+        size_t size;
+    };
+
+    void logAdapterUpdate(UpdateKind, const AdapterInfo&, Ice::Long);
+
     std::vector<AdapterObserverPrx> _publishers;
     std::map<std::string, AdapterInfo> _adapters;
+    std::deque<AdapterUpdate> _updates;
 };
 typedef IceUtil::Handle<AdapterObserverTopic> AdapterObserverTopicPtr;
 
@@ -167,12 +269,27 @@ public:
     int wellKnownObjectsAddedOrUpdated(const ObjectInfoSeq&);
     int wellKnownObjectsRemoved(const ObjectInfoSeq&);
 
-    virtual void initObserver(const Ice::ObjectPrx&);
+    virtual void initObserver(const Ice::ObjectPrx&, size_t);
+    virtual int sendLoggedUpdates(const Ice::ObjectPrx&, Ice::Long);
 
 private:
 
+    struct ObjectUpdate
+    {
+        UpdateKind kind;
+        ObjectInfo info;
+        Ice::Identity id;
+        int serial;
+        Ice::Long dbSerial;
+        bool serialized;
+        size_t size;
+    };
+
+    void logObjectUpdate(UpdateKind, const ObjectInfo&, const Ice::Identity&, Ice::Long);
+
     std::vector<ObjectObserverPrx> _publishers;
     std::map<Ice::Identity, ObjectInfo> _objects;
+    std::deque<ObjectUpdate> _updates;
 };
 typedef IceUtil::Handle<ObjectObserverTopic> ObjectObserverTopicPtr;
 
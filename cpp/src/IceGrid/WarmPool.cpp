@@ -0,0 +1,337 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceGrid/WarmPool.h>
+#include <IceGrid/AdapterCache.h>
+#include <IceGrid/Util.h>
+
+using namespace std;
+using namespace IceGrid;
+
+namespace
+{
+
+const string warmPoolPrefix = "IceGrid.Registry.WarmPool.";
+
+class ActivateCallback : public IceUtil::Shared
+{
+public:
+
+    ActivateCallback(const WarmPoolPtr& pool, const string& replicaGroupId, const string& id) :
+        _pool(pool),
+        _replicaGroupId(replicaGroupId),
+        _id(id)
+    {
+    }
+
+    void response(const Ice::ObjectPrx& proxy)
+    {
+        _pool->activated(_replicaGroupId, _id, proxy);
+    }
+
+    void exception(const Ice::Exception& ex)
+    {
+        _pool->activationFailed(_replicaGroupId, _id, ex);
+    }
+
+private:
+
+    const WarmPoolPtr _pool;
+    const string _replicaGroupId;
+    const string _id;
+};
+typedef IceUtil::Handle<ActivateCallback> ActivateCallbackPtr;
+
+}
+
+WarmPool::WarmPool(const Ice::CommunicatorPtr& communicator, AdapterCache& adapterCache,
+                   const TraceLevelsPtr& traceLevels) :
+    _adapterCache(adapterCache),
+    _traceLevels(traceLevels)
+{
+    Ice::PropertyDict props = communicator->getProperties()->getPropertiesForPrefix(warmPoolPrefix);
+    for(Ice::PropertyDict::const_iterator p = props.begin(); p != props.end(); ++p)
+    {
+        int size = communicator->getProperties()->getPropertyAsInt(p->first);
+        if(size > 0)
+        {
+            _sizes.insert(make_pair(p->first.substr(warmPoolPrefix.size()), size));
+        }
+    }
+}
+
+bool
+WarmPool::isEnabled() const
+{
+    return !_sizes.empty();
+}
+
+void
+WarmPool::nodeUp(const NodeDynamicInfo& info)
+{
+    if(_sizes.empty())
+    {
+        return;
+    }
+
+    {
+        Lock sync(*this);
+        for(AdapterDynamicInfoSeq::const_iterator p = info.adapters.begin(); p != info.adapters.end(); ++p)
+        {
+            if(p->proxy)
+            {
+                _active.insert(p->id);
+            }
+        }
+    }
+
+    //
+    // The servers of the node might be replicas of a pool.
+    //
+    runTimerTask();
+}
+
+void
+WarmPool::nodeDown(const NodeDynamicInfo& info)
+{
+    //
+    // The replicas of the node are no longer active. Replicas from other
+    // nodes are activated by the timer task, this is called with the node
+    // observer topic locked.
+    //
+    Lock sync(*this);
+    for(AdapterDynamicInfoSeq::const_iterator p = info.adapters.begin(); p != info.adapters.end(); ++p)
+    {
+        _active.erase(p->id);
+    }
+}
+
+void
+WarmPool::adapterChanged(const AdapterDynamicInfo& info)
+{
+    if(_sizes.empty())
+    {
+        return;
+    }
+
+    ServerAdapterEntryPtr adapter = getServerAdapter(info.id);
+    {
+        Lock sync(*this);
+        if(info.proxy)
+        {
+            //
+            // The server was started again, by a client request or by
+            // the admin interface.
+            //
+            _active.insert(info.id);
+            if(adapter)
+            {
+                _stopped.erase(adapter->getServerId());
+            }
+            return;
+        }
+        else if(_active.erase(info.id) == 0 || !adapter)
+        {
+            return;
+        }
+    }
+
+    //
+    // An active replica was deactivated, activate another replica if
+    // the pool of its replica group is no longer filled.
+    //
+    refill(adapter->getReplicaGroupId());
+}
+
+void
+WarmPool::serverStopped(const string& id)
+{
+    if(_sizes.empty())
+    {
+        return;
+    }
+
+    //
+    // Called before the server is stopped: the replicas of the server
+    // must not be activated again when their deactivation is notified.
+    //
+    Lock sync(*this);
+    _stopped.insert(id);
+}
+
+void
+WarmPool::serverStarted(const string& id)
+{
+    if(_sizes.empty())
+    {
+        return;
+    }
+
+    Lock sync(*this);
+    _stopped.erase(id);
+}
+
+void
+WarmPool::runTimerTask()
+{
+    for(map<string, int>::const_iterator p = _sizes.begin(); p != _sizes.end(); ++p)
+    {
+        refill(p->first);
+    }
+}
+
+void
+WarmPool::activated(const string& replicaGroupId, const string& id, const Ice::ObjectPrx& proxy)
+{
+    Lock sync(*this);
+    _activating.erase(id);
+    if(proxy)
+    {
+        _active.insert(id);
+    }
+
+    if(_traceLevels->adapter > 1)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
+        out << "activated replica `" << id << "' of warm pool `" << replicaGroupId << "'";
+    }
+}
+
+void
+WarmPool::activationFailed(const string& replicaGroupId, const string& id, const Ice::Exception& ex)
+{
+    Lock sync(*this);
+    _activating.erase(id);
+
+    if(_traceLevels->adapter > 1)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
+        out << "couldn't activate replica `" << id << "' of warm pool `" << replicaGroupId << "':\n"
+            << toString(ex);
+    }
+}
+
+void
+WarmPool::refill(const string& replicaGroupId)
+{
+    map<string, int>::const_iterator size = _sizes.find(replicaGroupId);
+    if(size == _sizes.end())
+    {
+        return;
+    }
+
+    vector<ServerAdapterEntryPtr> replicas;
+    try
+    {
+        ReplicaGroupEntryPtr entry = ReplicaGroupEntryPtr::dynamicCast(_adapterCache.get(replicaGroupId));
+        if(!entry)
+        {
+            return;
+        }
+        replicas = entry->getReplicas();
+    }
+    catch(const AdapterNotExistException&)
+    {
+        return;
+    }
+
+    //
+    // The enabled state of the servers is checked without holding the
+    // mutex, the node observer topic calls the pool with its mutex locked.
+    //
+    vector<ServerAdapterEntryPtr> candidates;
+    for(vector<ServerAdapterEntryPtr>::const_iterator p = replicas.begin(); p != replicas.end(); ++p)
+    {
+        if((*p)->isServerEnabled())
+        {
+            candidates.push_back(*p);
+        }
+    }
+
+    vector<pair<string, AdapterPrx> > activate;
+    {
+        Lock sync(*this);
+        int warm = 0;
+        for(vector<ServerAdapterEntryPtr>::const_iterator p = replicas.begin(); p != replicas.end(); ++p)
+        {
+            if(_active.find((*p)->getId()) != _active.end() || _activating.find((*p)->getId()) != _activating.end())
+            {
+                ++warm;
+            }
+        }
+
+        for(vector<ServerAdapterEntryPtr>::const_iterator p = candidates.begin(); p != candidates.end(); ++p)
+        {
+            if(warm >= size->second)
+            {
+                break;
+            }
+
+            const string id = (*p)->getId();
+            if(_active.find(id) != _active.end() || _activating.find(id) != _activating.end() ||
+               _stopped.find((*p)->getServerId()) != _stopped.end())
+            {
+                continue;
+            }
+
+            AdapterPrx proxy;
+            try
+            {
+                proxy = (*p)->getProxy("", true);
+            }
+            catch(const Ice::Exception&)
+            {
+                //
+                // The server isn't loaded on its node yet or the node is
+                // unreachable, the activation is retried by the timer.
+                //
+                continue;
+            }
+
+            _activating.insert(id);
+            activate.push_back(make_pair(id, proxy));
+            ++warm;
+        }
+    }
+
+    for(vector<pair<string, AdapterPrx> >::const_iterator p = activate.begin(); p != activate.end(); ++p)
+    {
+        if(_traceLevels->adapter > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->adapterCat);
+            out << "activating replica `" << p->first << "' of warm pool `" << replicaGroupId << "'";
+        }
+
+        ActivateCallbackPtr cb = new ActivateCallback(this, replicaGroupId, p->first);
+        try
+        {
+            p->second->begin_activate(newCallback_Adapter_activate(cb,
+                                                                   &ActivateCallback::response,
+                                                                   &ActivateCallback::exception));
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            cb->exception(ex);
+        }
+    }
+}
+
+ServerAdapterEntryPtr
+WarmPool::getServerAdapter(const string& id) const
+{
+    try
+    {
+        return ServerAdapterEntryPtr::dynamicCast(_adapterCache.get(id));
+    }
+    catch(const AdapterNotExistException&)
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,73 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_GRID_WARM_POOL_H
+#define ICE_GRID_WARM_POOL_H
+
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Timer.h>
+#include <IceGrid/Registry.h>
+#include <IceGrid/TraceLevels.h>
+
+#include <set>
+
+namespace IceGrid
+{
+
+class AdapterCache;
+class ServerAdapterEntry;
+typedef IceUtil::Handle<ServerAdapterEntry> ServerAdapterEntryPtr;
+
+//
+// The warm pool keeps a minimum number of replicas of a replica group
+// active so that locator requests for the replica group don't wait for
+// the activation of an on-demand server. The size of the pool of a
+// replica group is set with the IceGrid.Registry.WarmPool.<id>
+// property. Inactive replicas are activated in the background when an
+// active replica is deactivated and periodically, with the timer task,
+// to retry the activations which couldn't be started. Replicas of
+// disabled servers and of servers stopped with the admin interface
+// aren't activated, until the server is started again.
+//
+class WarmPool : public IceUtil::TimerTask, public IceUtil::Mutex
+{
+public:
+
+    WarmPool(const Ice::CommunicatorPtr&, AdapterCache&, const TraceLevelsPtr&);
+
+    bool isEnabled() const;
+
+    void nodeUp(const NodeDynamicInfo&);
+    void nodeDown(const NodeDynamicInfo&);
+    void adapterChanged(const AdapterDynamicInfo&);
+    void serverStopped(const std::string&);
+    void serverStarted(const std::string&);
+
+    virtual void runTimerTask();
+
+    void activated(const std::string&, const std::string&, const Ice::ObjectPrx&);
+    void activationFailed(const std::string&, const std::string&, const Ice::Exception&);
+
+private:
+
+    void refill(const std::string&);
+    ServerAdapterEntryPtr getServerAdapter(const std::string&) const;
+
+    AdapterCache& _adapterCache;
+    const TraceLevelsPtr _traceLevels;
+    std::map<std::string, int> _sizes;
+    std::set<std::string> _active;
+    std::set<std::string> _activating;
+    std::set<std::string> _stopped; // The servers stopped with the admin interface.
+};
+typedef IceUtil::Handle<WarmPool> WarmPoolPtr;
+
+}
+
+#endif
@@ -0,0 +1,506 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/EventLog.h>
+#include <Ice/Ice.h>
+#include <IceUtil/FileUtil.h>
+#include <Ice/Network.h>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+using namespace std;
+using namespace IceStorm;
+
+const string EventLog::sequenceKey = "IceStorm.Sequence";
+
+namespace
+{
+
+//
+// Each record holds its size, the event sequence number and the event.
+//
+const size_t recordHeaderSize = 4 + 8;
+
+const string indexFile = "segments";
+
+void
+syncFile(FILE* file)
+{
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+int
+duplicateFile(FILE* file)
+{
+#ifdef _WIN32
+    return _dup(_fileno(file));
+#else
+    return dup(fileno(file));
+#endif
+}
+
+void
+syncAndClose(int fd)
+{
+#ifdef _WIN32
+    _commit(fd);
+    _close(fd);
+#else
+    fsync(fd);
+    ::close(fd);
+#endif
+}
+
+void
+truncateFile(FILE* file, Ice::Long size)
+{
+#ifdef _WIN32
+    _chsize_s(_fileno(file), size);
+#else
+    if(ftruncate(fileno(file), static_cast<off_t>(size)) != 0)
+    {
+        // Ignore, the trailing bytes are ignored when the segment is read.
+    }
+#endif
+}
+
+//
+// Seek with a 64-bit offset, fseek only takes a long which is 32-bit
+// on Windows.
+//
+void
+seekFile(FILE* file, Ice::Long offset)
+{
+#ifdef _WIN32
+    _fseeki64(file, offset, SEEK_SET);
+#else
+    fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+}
+
+EventLog::EventLog(const Ice::CommunicatorPtr& communicator, const string& path, Ice::Long segmentSize,
+                   int maxSegments) :
+    _communicator(communicator),
+    _path(path),
+    _segmentSize(segmentSize),
+    _maxSegments(static_cast<size_t>(max(maxSegments, 1))),
+    _file(0),
+    _fileSize(0),
+    _next(1),
+    _dirty(false)
+{
+    if(!IceUtilInternal::directoryExists(_path) && IceUtilInternal::mkdir(_path, 0777) != 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), _path);
+    }
+
+    //
+    // The index is replaced by renaming a temporary file, if it's
+    // missing the rename didn't complete.
+    //
+    string index = _path + "/" + indexFile;
+    if(!IceUtilInternal::fileExists(index))
+    {
+        index += ".tmp";
+    }
+    ifstream is(IceUtilInternal::streamFilename(index).c_str()); // index is a UTF-8 string
+    Ice::Long seq;
+    while(is >> seq)
+    {
+        _segments.push_back(seq);
+    }
+
+    if(_segments.empty())
+    {
+        _segments.push_back(_next);
+        writeIndex();
+        openSegment(segmentPath(_next), "wb");
+        return;
+    }
+
+    //
+    // Find the next sequence number from the last segment and drop any
+    // partially written record at its end.
+    //
+    _next = _segments.back();
+    vector<Ice::Byte> data;
+    string segment = segmentPath(_segments.back());
+    readFile(segment, data);
+    _fileSize = static_cast<Ice::Long>(parse(data, _next, _next, 0));
+
+    openSegment(segment, IceUtilInternal::fileExists(segment) ? "r+b" : "wb");
+    if(_fileSize < static_cast<Ice::Long>(data.size()))
+    {
+        truncateFile(_file, _fileSize);
+    }
+    seekFile(_file, _fileSize);
+}
+
+EventLog::~EventLog()
+{
+    if(_file)
+    {
+        fclose(_file);
+    }
+}
+
+void
+EventLog::append(const EventDataSeq& events)
+{
+    Lock sync(*this);
+
+    if(!_file)
+    {
+        return;
+    }
+
+    //
+    // Start a new segment if the current one is full, removing the
+    // oldest segment if the log has reached its maximum size.
+    //
+    if(_fileSize >= _segmentSize)
+    {
+        fflush(_file);
+        syncFile(_file);
+        fclose(_file);
+        _file = 0;
+
+        _segments.push_back(_next);
+        while(_segments.size() > _maxSegments)
+        {
+            IceUtilInternal::unlink(segmentPath(_segments.front()));
+            _segments.pop_front();
+        }
+        writeIndex();
+        openSegment(segmentPath(_next), "wb");
+        _fileSize = 0;
+    }
+
+    Ice::OutputStream stream(_communicator, Ice::Encoding_1_1);
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        ostringstream os;
+        os << _next;
+        (*p)->context[sequenceKey] = os.str();
+
+        Ice::OutputStream::size_type pos = stream.b.size();
+        stream.write(Ice::Int(0));
+        stream.write(_next++);
+        stream.write(*p);
+        stream.rewrite(static_cast<Ice::Int>(stream.b.size() - pos), pos);
+    }
+
+    if(fwrite(stream.b.begin(), 1, stream.b.size(), _file) != stream.b.size())
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), segmentPath(_segments.back()));
+    }
+    _fileSize += static_cast<Ice::Long>(stream.b.size());
+    _dirty = true;
+}
+
+void
+EventLog::read(Position& position, size_t max, EventDataSeq& events)
+{
+    while(events.size() < max)
+    {
+        string path;
+        Ice::Long next = 0; // The first event of the next segment, 0 if reading the last segment.
+        {
+            Lock sync(*this);
+            if(_segments.empty())
+            {
+                return;
+            }
+
+            //
+            // Find the segment holding the next event. If the segment was
+            // removed, the oldest events of the log are read instead.
+            //
+            if(position.segment < _segments.front())
+            {
+                deque<Ice::Long>::const_iterator p = upper_bound(_segments.begin(), _segments.end(), position.seq);
+                if(p != _segments.begin())
+                {
+                    --p;
+                }
+                position.seq = std::max(position.seq, *p);
+                position.segment = *p;
+                position.offset = 0;
+            }
+
+            deque<Ice::Long>::const_iterator p = find(_segments.begin(), _segments.end(), position.segment);
+            assert(p != _segments.end());
+            if(p + 1 != _segments.end())
+            {
+                next = *(p + 1);
+            }
+            else if(_file)
+            {
+                fflush(_file);
+            }
+            path = segmentPath(position.segment);
+        }
+
+        //
+        // The segment is read without the mutex locked, appends aren't
+        // blocked by the reading of the log.
+        //
+        readSegment(path, position, max, events);
+        if(events.size() >= max || next == 0)
+        {
+            return;
+        }
+
+        //
+        // The end of the segment was reached, continue with the next one.
+        //
+        position.seq = std::max(position.seq, next);
+        position.segment = next;
+        position.offset = 0;
+    }
+}
+
+Ice::Long
+EventLog::next()
+{
+    Lock sync(*this);
+    return _next;
+}
+
+void
+EventLog::close()
+{
+    Lock sync(*this);
+    if(_file)
+    {
+        fflush(_file);
+        syncFile(_file);
+        fclose(_file);
+        _file = 0;
+    }
+}
+
+void
+EventLog::destroy()
+{
+    close();
+
+    Lock sync(*this);
+    for(deque<Ice::Long>::const_iterator p = _segments.begin(); p != _segments.end(); ++p)
+    {
+        IceUtilInternal::unlink(segmentPath(*p));
+    }
+    _segments.clear();
+    IceUtilInternal::unlink(_path + "/" + indexFile);
+    IceUtilInternal::rmdir(_path);
+}
+
+void
+EventLog::runTimerTask()
+{
+    //
+    // The buffered writes are flushed with the mutex locked and synced
+    // to disk without it, append() is called by publishers and mustn't
+    // wait for the disk. A duplicate of the file descriptor is synced
+    // since the segment can be closed in the meantime.
+    //
+    int fd;
+    {
+        Lock sync(*this);
+        if(!_file || !_dirty)
+        {
+            return;
+        }
+        fflush(_file);
+        fd = duplicateFile(_file);
+        if(fd < 0)
+        {
+            return;
+        }
+        _dirty = false;
+    }
+    syncAndClose(fd);
+}
+
+size_t
+EventLog::parse(const vector<Ice::Byte>& data, Ice::Long& seq, Ice::Long from, EventDataSeq* events) const
+{
+    if(data.empty())
+    {
+        return 0;
+    }
+
+    Ice::InputStream stream(_communicator, Ice::Encoding_1_1, make_pair(&data[0], &data[0] + data.size()));
+    size_t pos = 0;
+    while(data.size() - pos >= recordHeaderSize)
+    {
+        stream.pos(pos);
+
+        Ice::Int size;
+        Ice::Long s;
+        stream.read(size);
+        stream.read(s);
+        if(size < static_cast<Ice::Int>(recordHeaderSize) || static_cast<size_t>(size) > data.size() - pos ||
+           s != seq)
+        {
+            break; // Partially written record.
+        }
+
+        if(events && s >= from)
+        {
+            EventDataPtr event = new EventData;
+            try
+            {
+                stream.read(event);
+            }
+            catch(const Ice::MarshalException&)
+            {
+                break;
+            }
+            events->push_back(event);
+        }
+
+        pos += static_cast<size_t>(size);
+        ++seq;
+    }
+    return pos;
+}
+
+void
+EventLog::readFile(const string& path, vector<Ice::Byte>& data) const
+{
+    ifstream is(IceUtilInternal::streamFilename(path).c_str(), ios::binary); // path is a UTF-8 string
+    if(!is)
+    {
+        return;
+    }
+    is.seekg(0, ios::end);
+    streamoff size = is.tellg();
+    is.seekg(0, ios::beg);
+    if(size > 0)
+    {
+        data.resize(static_cast<size_t>(size));
+        is.read(reinterpret_cast<char*>(&data[0]), size);
+        data.resize(static_cast<size_t>(is.gcount()));
+    }
+}
+
+void
+EventLog::readSegment(const string& path, Position& position, size_t max, EventDataSeq& events) const
+{
+    ifstream is(IceUtilInternal::streamFilename(path).c_str(), ios::binary); // path is a UTF-8 string
+    if(!is || !is.seekg(static_cast<streamoff>(position.offset)))
+    {
+        return;
+    }
+
+    //
+    // The record at the position offset holds the first event of the
+    // segment or the next event to read.
+    //
+    Ice::Long seq = position.offset == 0 ? position.segment : position.seq;
+    vector<Ice::Byte> data;
+    while(events.size() < max)
+    {
+        Ice::Byte header[recordHeaderSize];
+        if(!is.read(reinterpret_cast<char*>(header), recordHeaderSize))
+        {
+            break;
+        }
+
+        Ice::InputStream stream(_communicator, Ice::Encoding_1_1, make_pair(header, header + recordHeaderSize));
+        Ice::Int size;
+        Ice::Long s;
+        stream.read(size);
+        stream.read(s);
+        if(size < static_cast<Ice::Int>(recordHeaderSize) || s != seq)
+        {
+            break; // Partially written record.
+        }
+
+        data.resize(static_cast<size_t>(size) - recordHeaderSize);
+        if(!data.empty() && !is.read(reinterpret_cast<char*>(&data[0]), static_cast<streamsize>(data.size())))
+        {
+            break; // Partially written record.
+        }
+
+        if(s >= position.seq)
+        {
+            EventDataPtr event = new EventData;
+            try
+            {
+                Ice::InputStream in(_communicator, Ice::Encoding_1_1, data);
+                in.read(event);
+            }
+            catch(const Ice::MarshalException&)
+            {
+                break;
+            }
+            events.push_back(event);
+            position.seq = s + 1;
+        }
+        position.offset += size;
+        ++seq;
+    }
+}
+
+void
+EventLog::openSegment(const string& path, const char* mode)
+{
+    _file = IceUtilInternal::fopen(path, mode);
+    if(!_file)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), path);
+    }
+}
+
+void
+EventLog::writeIndex()
+{
+    string index = _path + "/" + indexFile;
+    {
+        ofstream os(IceUtilInternal::streamFilename(index + ".tmp").c_str()); // index is a UTF-8 string
+        for(deque<Ice::Long>::const_iterator p = _segments.begin(); p != _segments.end(); ++p)
+        {
+            os << *p << '\n';
+        }
+        if(!os)
+        {
+            throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), index + ".tmp");
+        }
+    }
+#ifdef _WIN32
+    IceUtilInternal::remove(index);
+#endif
+    if(IceUtilInternal::rename(index + ".tmp", index) != 0)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), index);
+    }
+}
+
+string
+EventLog::segmentPath(Ice::Long seq) const
+{
+    ostringstream os;
+    os << _path << '/' << setw(20) << setfill('0') << seq << ".log";
+    return os.str();
+}
@@ -0,0 +1,89 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <IceStorm/IceStormInternal.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Timer.h>
+#include <deque>
+#include <cstdio>
+
+namespace IceStorm
+{
+
+//
+// The log of the events published on a durable topic. Events are
+// appended to segment files named after the sequence number of their
+// first event, the oldest segment is removed when the maximum number
+// of segments is reached. Writes are synced to disk by the timer task.
+//
+class EventLog : public IceUtil::TimerTask, private IceUtil::Mutex
+{
+public:
+
+    //
+    // The position of the next event to read from the log.
+    //
+    struct Position
+    {
+        Position(Ice::Long s) : seq(s), segment(0), offset(0)
+        {
+        }
+
+        Ice::Long seq; // The sequence number of the next event.
+        Ice::Long segment; // The segment holding the next event, 0 if not known yet.
+        Ice::Long offset; // The offset of the next event in its segment.
+    };
+
+    EventLog(const Ice::CommunicatorPtr&, const std::string&, Ice::Long, int);
+    ~EventLog();
+
+    // Append the events to the log and set their sequence number in the event context.
+    void append(const EventDataSeq&);
+
+    // Read up to the given number of logged events, the position is moved past the events read.
+    void read(Position&, size_t, EventDataSeq&);
+
+    // Get the sequence number of the next event appended to the log.
+    Ice::Long next();
+
+    void close();
+    void destroy(); // Close the log and remove its files.
+
+    virtual void runTimerTask();
+
+    static const std::string sequenceKey; // The event context key for the sequence number.
+
+private:
+
+    size_t parse(const std::vector<Ice::Byte>&, Ice::Long&, Ice::Long, EventDataSeq*) const;
+    void readSegment(const std::string&, Position&, size_t, EventDataSeq&) const;
+    void readFile(const std::string&, std::vector<Ice::Byte>&) const;
+    void openSegment(const std::string&, const char*);
+    void writeIndex();
+    std::string segmentPath(Ice::Long) const;
+
+    const Ice::CommunicatorPtr _communicator;
+    const std::string _path;
+    const Ice::Long _segmentSize;
+    const size_t _maxSegments;
+
+    std::deque<Ice::Long> _segments; // The sequence number of the first event of each segment.
+    FILE* _file; // The last segment.
+    Ice::Long _fileSize;
+    Ice::Long _next; // The sequence number of the next event.
+    bool _dirty; // Has the log been written to since the last sync?
+};
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+} // End namespace IceStorm
+
+#endif
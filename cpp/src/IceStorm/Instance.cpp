@@ -12,12 +12,19 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/Subscriber.h>
+#include <IceStorm/SendThreadPool.h>
+#include <IceStorm/EventLog.h>
+#include <IceStorm/ShardMap.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/FileUtil.h>
 
 #include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
 #include <Ice/Properties.h>
 #include <Ice/TraceUtil.h>
+#include <Ice/Network.h>
+#include <iomanip>
 
 using namespace std;
 using namespace IceStorm;
@@ -70,6 +77,28 @@ PersistentInstance::PersistentInstance(
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
 
         txn.commit();
+
+        //
+        // Durable topics log their events, this isn't supported with
+        // replication since events are not replicated.
+        //
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        Ice::StringSeq durableTopics = properties->getPropertyAsList(name + ".Durable.Topics");
+        if(!durableTopics.empty() && nodeAdapter)
+        {
+            Ice::Warning warn(traceLevels()->logger);
+            warn << "durable topics are not supported with replication, ignoring `" << name << ".Durable.Topics'";
+        }
+        else if(!durableTopics.empty())
+        {
+            _durableTopics.insert(durableTopics.begin(), durableTopics.end());
+            string dbPath = properties->getPropertyWithDefault(name + ".LMDB.Path", name);
+            _durablePath = properties->getPropertyWithDefault(name + ".Durable.Path", dbPath + "/events");
+            if(!IceUtilInternal::directoryExists(_durablePath) && IceUtilInternal::mkdir(_durablePath, 0777) != 0)
+            {
+                throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), _durablePath);
+            }
+        }
     }
     catch(...)
     {
@@ -80,6 +109,48 @@ PersistentInstance::PersistentInstance(
     }
 }
 
+EventLogPtr
+PersistentInstance::createEventLog(const string& topic) const
+{
+    if(_durableTopics.find(topic) == _durableTopics.end())
+    {
+        return 0;
+    }
+
+    //
+    // The log directory is named after the topic, with the characters
+    // which might not be valid in a file name escaped.
+    //
+    ostringstream os;
+    os << _durablePath << '/';
+    for(string::const_iterator p = topic.begin(); p != topic.end(); ++p)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if(isalnum(c) || c == '-' || c == '_' || c == '.')
+        {
+            os << *p;
+        }
+        else
+        {
+            os << '%' << hex << uppercase << setw(2) << setfill('0') << static_cast<int>(c) << dec;
+        }
+    }
+
+    Ice::PropertiesPtr properties = communicator()->getProperties();
+    const string name = serviceName();
+    Ice::Long segmentSize = static_cast<Ice::Long>(
+        max(properties->getPropertyAsIntWithDefault(name + ".Durable.SegmentSize", 16), 1)) * 1024 * 1024;
+    EventLogPtr log = new EventLog(communicator(), os.str(), segmentSize,
+                                   properties->getPropertyAsIntWithDefault(name + ".Durable.MaxSegments", 16));
+
+    //
+    // Writes are synced to disk periodically rather than for each event.
+    //
+    int interval = properties->getPropertyAsIntWithDefault(name + ".Durable.SyncInterval", 100);
+    timer()->scheduleRepeated(log, IceUtil::Time::milliSeconds(max(interval, 1)));
+    return log;
+}
+
 void
 PersistentInstance::destroy()
 {
@@ -109,6 +180,10 @@ Instance::Instance(
                                                 name + ".Discard.Interval", 60))), // default one minute.
     _flushInterval(IceUtil::Time::milliSeconds(communicator->getProperties()->getPropertyAsIntWithDefault(
                                                    name + ".Flush.Timeout", 1000))), // default one second.
+    _flushAdaptive(communicator->getProperties()->getPropertyAsInt(name + ".Flush.Adaptive") > 0),
+    // default 1MB.
+    _flushMaxSize(static_cast<size_t>(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                                              name + ".Flush.MaxSize", 1024), 1)) * 1024),
     // default one minute.
     _sendTimeout(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.Timeout", 60 * 1000)),
     _sendQueueSizeMax(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".Send.QueueSizeMax", -1)),
@@ -136,6 +211,31 @@ Instance::Instance(
         _observers = new Observers(this);
         _batchFlusher = new IceUtil::Timer();
         _timer = new IceUtil::Timer();
+        _sendThreadPool = new SendThreadPool(_traceLevels->logger,
+                                             properties->getPropertyAsInt(name + ".Send.Threads"));
+
+        Ice::PropertyDict shards = properties->getPropertiesForPrefix(name + ".Shards.");
+        if(!shards.empty())
+        {
+            string shard = properties->getProperty(name + ".Shard.Name");
+            map<string, TopicManagerPrx> managers;
+            for(Ice::PropertyDict::const_iterator p = shards.begin(); p != shards.end(); ++p)
+            {
+                managers[p->first.substr(name.size() + 8)] =
+                    TopicManagerPrx::uncheckedCast(communicator->stringToProxy(p->second));
+            }
+
+            if(managers.find(shard) == managers.end())
+            {
+                Ice::Warning warn(_traceLevels->logger);
+                warn << "ignoring `" << name << ".Shards' properties: `" << name << ".Shard.Name' must be set to "
+                     << "one of the shard names";
+            }
+            else
+            {
+                _shards = new ShardMap(shard, managers, _traceLevels);
+            }
+        }
 
         string policy = properties->getProperty(name + ".Send.QueueSizeMaxPolicy");
         if(policy == "RemoveSubscriber")
@@ -258,6 +358,18 @@ Instance::timer() const
     return _timer;
 }
 
+SendThreadPoolPtr
+Instance::sendThreadPool() const
+{
+    return _sendThreadPool;
+}
+
+ShardMapPtr
+Instance::shards() const
+{
+    return _shards;
+}
+
 Ice::ObjectPrx
 Instance::topicReplicaProxy() const
 {
@@ -294,6 +406,18 @@ Instance::flushInterval() const
     return _flushInterval;
 }
 
+bool
+Instance::flushAdaptive() const
+{
+    return _flushAdaptive;
+}
+
+size_t
+Instance::flushMaxSize() const
+{
+    return _flushMaxSize;
+}
+
 int
 Instance::sendTimeout() const
 {
@@ -339,6 +463,11 @@ Instance::destroy()
         _batchFlusher->destroy();
     }
 
+    if(_sendThreadPool)
+    {
+        _sendThreadPool->destroy();
+    }
+
     // The node instance must be cleared as the node holds the
     // replica (TopicManager) which holds the instance causing a
     // cyclic reference.
@@ -18,6 +18,7 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <set>
 
 namespace IceUtil
 {
@@ -44,6 +45,15 @@ namespace IceStorm
 class TraceLevels;
 typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
+class SendThreadPool;
+typedef IceUtil::Handle<SendThreadPool> SendThreadPoolPtr;
+
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+class ShardMap;
+typedef IceUtil::Handle<ShardMap> ShardMapPtr;
+
 class TopicReaper : public IceUtil::Shared, private IceUtil::Mutex
 {
 public:
@@ -85,6 +95,8 @@ public:
     TraceLevelsPtr traceLevels() const;
     IceUtil::TimerPtr batchFlusher() const;
     IceUtil::TimerPtr timer() const;
+    SendThreadPoolPtr sendThreadPool() const;
+    ShardMapPtr shards() const; // Null unless the service is a shard of a sharded deployment.
     Ice::ObjectPrx topicReplicaProxy() const;
     Ice::ObjectPrx publisherReplicaProxy() const;
     IceStorm::Instrumentation::TopicManagerObserverPtr observer() const;
@@ -92,6 +104,8 @@ public:
 
     IceUtil::Time discardInterval() const;
     IceUtil::Time flushInterval() const;
+    bool flushAdaptive() const;
+    size_t flushMaxSize() const;
     int sendTimeout() const;
     int sendQueueSizeMax() const;
     SendQueueSizeMaxPolicy sendQueueSizeMaxPolicy() const;
@@ -111,6 +125,8 @@ private:
     const TraceLevelsPtr _traceLevels;
     const IceUtil::Time _discardInterval;
     const IceUtil::Time _flushInterval;
+    const bool _flushAdaptive;
+    const size_t _flushMaxSize;
     const int _sendTimeout;
     const int _sendQueueSizeMax;
     const SendQueueSizeMaxPolicy _sendQueueSizeMaxPolicy;
@@ -121,6 +137,8 @@ private:
     IceStormElection::ObserversPtr _observers;
     IceUtil::TimerPtr _batchFlusher;
     IceUtil::TimerPtr _timer;
+    SendThreadPoolPtr _sendThreadPool;
+    ShardMapPtr _shards;
     IceStorm::Instrumentation::TopicManagerObserverPtr _observer;
 
 
@@ -142,6 +160,9 @@ public:
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
 
+    // Create the event log of a durable topic, returns null if the topic isn't durable.
+    EventLogPtr createEventLog(const std::string&) const;
+
     virtual void destroy();
 
 private:
@@ -150,6 +171,8 @@ private:
     IceDB::Env _dbEnv;
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    std::set<std::string> _durableTopics;
+    std::string _durablePath;
 };
 typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 
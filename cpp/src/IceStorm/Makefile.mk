@@ -16,17 +16,21 @@ $(project)_dependencies		:= IceStorm Ice
 IceStormService_targetdir	:= $(libdir)
 IceStormService_dependencies 	:= IceGrid Glacier2 IceBox IceDB
 IceStormService_cppflags	:= $(if $(lmdb_includedir),-I$(lmdb_includedir))
-IceStormService_sources   	:= $(addprefix $(currentdir)/,Instance.cpp \
+IceStormService_sources   	:= $(addprefix $(currentdir)/,EventLog.cpp \
+							     Instance.cpp \
 							     InstrumentationI.cpp \
 							     NodeI.cpp \
 							     Observers.cpp \
+							     SendThreadPool.cpp \
 							     Service.cpp \
+							     ShardMap.cpp \
 							     Subscriber.cpp \
 							     TopicI.cpp \
 							     TopicManagerI.cpp \
 							     TraceLevels.cpp \
 							     TransientTopicI.cpp \
 							     TransientTopicManagerI.cpp \
+							     UpdateLog.cpp \
 							     Util.cpp \
 							     Election.ice \
 							     IceStormInternal.ice \
@@ -19,6 +19,12 @@ Observers::Observers(const InstancePtr& instance) :
     _traceLevels(instance->traceLevels()),
     _majority(0)
 {
+    if(instance->nodeAdapter())
+    {
+        Ice::PropertiesPtr properties = instance->communicator()->getProperties();
+        int size = properties->getPropertyAsIntWithDefault(instance->serviceName() + ".Replication.LogSize", 10000);
+        const_cast<UpdateLogPtr&>(_updateLog) = new UpdateLog(static_cast<size_t>(max(size, 0)));
+    }
 }
 
 void
@@ -78,7 +84,8 @@ Observers::getReapedSlaves(std::vector<int>& d)
 }
 
 void
-Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const TopicContentSeq& content)
+Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const map<int, TopicUpdateSeq>& updates,
+                const vector<TopicContentSeq>& content)
 {
     {
         IceUtil::Mutex::Lock sync(_reapedMutex);
@@ -89,17 +96,79 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
     _observers.clear();
 
     vector<ObserverInfo> observers;
-
     for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p)
     {
-        try
+        assert(p->observer);
+        observers.push_back(ObserverInfo(p->id, ReplicaObserverPrx::uncheckedCast(p->observer)));
+    }
+
+    //
+    // The slaves that can't be sent the updates they missed are sent
+    // the topic content. It's sent in chunks, the last chunk is sent
+    // with init.
+    //
+    for(vector<TopicContentSeq>::size_type i = 0; i + 1 < content.size(); ++i)
+    {
+        for(vector<ObserverInfo>::iterator p = observers.begin(); p != observers.end(); ++p)
         {
-            assert(p->observer);
+            if(updates.find(p->id) == updates.end())
+            {
+                try
+                {
+                    p->result = p->observer->begin_initChunk(llu, content[i]);
+                }
+                catch(const Ice::Exception& ex)
+                {
+                    if(_traceLevels->replication > 0)
+                    {
+                        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                        out << "error calling initChunk on " << p->id << ", exception: " << ex;
+                    }
+                    throw;
+                }
+            }
+        }
 
-            ReplicaObserverPrx observer = ReplicaObserverPrx::uncheckedCast(p->observer);
+        for(vector<ObserverInfo>::iterator p = observers.begin(); p != observers.end(); ++p)
+        {
+            if(p->result)
+            {
+                try
+                {
+                    p->observer->end_initChunk(p->result);
+                    p->result = 0;
+                }
+                catch(const Ice::Exception& ex)
+                {
+                    if(_traceLevels->replication > 0)
+                    {
+                        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                        out << "initChunk on " << p->id << " failed with exception " << ex;
+                    }
+                    throw;
+                }
+            }
+        }
+    }
 
-            Ice::AsyncResultPtr result = observer->begin_init(llu, content);
-            observers.push_back(ObserverInfo(p->id, observer, result));
+    for(vector<ObserverInfo>::iterator p = observers.begin(); p != observers.end(); ++p)
+    {
+        try
+        {
+            map<int, TopicUpdateSeq>::const_iterator q = updates.find(p->id);
+            if(q != updates.end())
+            {
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "sending " << q->second.size() << " missed updates to " << p->id;
+                }
+                p->result = p->observer->begin_initUpdates(llu, q->second);
+            }
+            else
+            {
+                p->result = p->observer->begin_init(llu, content.empty() ? TopicContentSeq() : content.back());
+            }
         }
         catch(const Ice::Exception& ex)
         {
@@ -116,7 +185,14 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
     {
         try
         {
-            p->observer->end_init(p->result);
+            if(updates.find(p->id) != updates.end())
+            {
+                p->observer->end_initUpdates(p->result);
+            }
+            else
+            {
+                p->observer->end_init(p->result);
+            }
             p->result = 0;
         }
         catch(const Ice::Exception& ex)
@@ -136,6 +212,11 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 void
 Observers::createTopic(const LogUpdate& llu, const string& name)
 {
+    if(_updateLog)
+    {
+        _updateLog->createTopic(llu, name);
+    }
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -147,6 +228,11 @@ Observers::createTopic(const LogUpdate& llu, const string& name)
 void
 Observers::destroyTopic(const LogUpdate& llu, const string& id)
 {
+    if(_updateLog)
+    {
+        _updateLog->destroyTopic(llu, id);
+    }
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -159,6 +245,11 @@ Observers::destroyTopic(const LogUpdate& llu, const string& id)
 void
 Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
 {
+    if(_updateLog)
+    {
+        _updateLog->addSubscriber(llu, name, rec);
+    }
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -170,6 +261,11 @@ Observers::addSubscriber(const LogUpdate& llu, const string& name, const Subscri
 void
 Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
 {
+    if(_updateLog)
+    {
+        _updateLog->removeSubscriber(llu, name, id);
+    }
+
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
@@ -178,6 +274,12 @@ Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice:
     wait("removeSubscriber");
 }
 
+UpdateLogPtr
+Observers::updateLog() const
+{
+    return _updateLog;
+}
+
 void
 Observers::wait(const string& op)
 {
@@ -14,6 +14,7 @@
 #include <IceUtil/IceUtil.h>
 #include <IceStorm/Election.h>
 #include <IceStorm/Replica.h>
+#include <IceStorm/UpdateLog.h>
 
 #ifdef __SUNPRO_CC
 #  pragma error_messages(off,hidef)
@@ -42,18 +43,22 @@ public:
     bool check();
     void clear();
 
-    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const TopicContentSeq&);
+    void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const std::map<int, TopicUpdateSeq>&,
+              const std::vector<TopicContentSeq>&);
     void createTopic(const LogUpdate&, const std::string&);
     void destroyTopic(const LogUpdate&, const std::string&);
     void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
     void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
     void getReapedSlaves(std::vector<int>&);
 
+    UpdateLogPtr updateLog() const;
+
 private:
 
     void wait(const std::string&);
 
     const IceStorm::TraceLevelsPtr _traceLevels;
+    const UpdateLogPtr _updateLog; // Only set with replication.
     unsigned int _majority;
     struct ObserverInfo
     {
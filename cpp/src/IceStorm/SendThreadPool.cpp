@@ -0,0 +1,222 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/SendThreadPool.h>
+#include <Ice/LoggerUtil.h>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// Topics with less than this number of subscribers per send thread
+// are not worth splitting.
+//
+const size_t minSubscribersPerShard = 64;
+
+void
+queueEvents(bool forwarded, const EventDataSeq& events, vector<SubscriberPtr>::const_iterator p,
+            vector<SubscriberPtr>::const_iterator end, Ice::IdentitySeq& reap)
+{
+    for(; p != end; ++p)
+    {
+        if(!(*p)->queue(forwarded, events) && (*p)->reap())
+        {
+            reap.push_back((*p)->id());
+        }
+    }
+}
+
+class SendThread : public IceUtil::Thread
+{
+public:
+
+    SendThread(SendThreadPool* pool) :
+        IceUtil::Thread("IceStorm send thread"),
+        _pool(pool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _pool->run();
+    }
+
+private:
+
+    SendThreadPool* _pool; // Not a handle, SendThreadPool::destroy() joins the thread.
+};
+
+}
+
+struct SendThreadPool::Shard
+{
+    vector<SubscriberPtr>::const_iterator begin;
+    vector<SubscriberPtr>::const_iterator end;
+    bool forwarded;
+    const EventDataSeq* events;
+    Ice::IdentitySeq reap;
+    int* pending;
+};
+
+SendThreadPool::SendThreadPool(const Ice::LoggerPtr& logger, int size) :
+    _logger(logger),
+    _destroyed(false)
+{
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            IceUtil::ThreadPtr thread = new SendThread(this);
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        throw;
+    }
+}
+
+void
+SendThreadPool::queue(bool forwarded, const EventDataSeq& events, const vector<SubscriberPtr>& subscribers,
+                      Ice::IdentitySeq& reap)
+{
+    size_t count = min(_threads.size() + 1, subscribers.size() / minSubscribersPerShard);
+    if(count <= 1)
+    {
+        queueEvents(forwarded, events, subscribers.begin(), subscribers.end(), reap);
+        return;
+    }
+
+    //
+    // The publishing thread takes care of the first shard, the send
+    // threads of the others. The last shard also gets the remainder.
+    //
+    size_t size = subscribers.size() / count;
+    vector<Shard> shards(count - 1);
+    int pending = static_cast<int>(shards.size());
+    {
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            queueEvents(forwarded, events, subscribers.begin(), subscribers.end(), reap);
+            return;
+        }
+
+        vector<SubscriberPtr>::const_iterator p = subscribers.begin() + size;
+        for(vector<Shard>::iterator q = shards.begin(); q != shards.end(); ++q)
+        {
+            q->begin = p;
+            q->end = q + 1 == shards.end() ? subscribers.end() : p + size;
+            q->forwarded = forwarded;
+            q->events = &events;
+            q->pending = &pending;
+            _shards.push_back(&*q);
+            p = q->end;
+        }
+        notifyAll();
+    }
+
+    try
+    {
+        queueEvents(forwarded, events, subscribers.begin(), subscribers.begin() + size, reap);
+    }
+    catch(...)
+    {
+        //
+        // The send threads still use the shards and the pending count
+        // allocated on this stack, wait for them before unwinding.
+        //
+        Lock sync(*this);
+        while(pending > 0)
+        {
+            wait();
+        }
+        throw;
+    }
+
+    {
+        Lock sync(*this);
+        while(pending > 0)
+        {
+            wait();
+        }
+    }
+
+    for(vector<Shard>::const_iterator q = shards.begin(); q != shards.end(); ++q)
+    {
+        reap.insert(reap.end(), q->reap.begin(), q->reap.end());
+    }
+}
+
+void
+SendThreadPool::destroy()
+{
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
+}
+
+void
+SendThreadPool::run()
+{
+    while(true)
+    {
+        Shard* shard;
+        {
+            Lock sync(*this);
+            while(_shards.empty() && !_destroyed)
+            {
+                wait();
+            }
+            if(_shards.empty())
+            {
+                return;
+            }
+            shard = _shards.front();
+            _shards.pop_front();
+        }
+
+        try
+        {
+            queueEvents(shard->forwarded, *shard->events, shard->begin, shard->end, shard->reap);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            Ice::Warning out(_logger);
+            out << "unexpected exception while queuing events:\n" << ex;
+        }
+        catch(const std::exception& ex)
+        {
+            Ice::Warning out(_logger);
+            out << "unexpected exception while queuing events:\n" << ex.what();
+        }
+
+        {
+            Lock sync(*this);
+            if(--*shard->pending == 0)
+            {
+                notifyAll();
+            }
+        }
+    }
+}
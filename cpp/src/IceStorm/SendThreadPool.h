@@ -0,0 +1,59 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef SEND_THREAD_POOL_H
+#define SEND_THREAD_POOL_H
+
+#include <IceStorm/Subscriber.h>
+#include <IceUtil/Thread.h>
+#include <deque>
+
+namespace IceStorm
+{
+
+//
+// Threads helping the publishing thread to queue events to the
+// subscribers of topics with many subscribers. The subscriber list is
+// split into shards, the publishing thread queues the events to the
+// first shard and waits for the send threads to queue them to the
+// others (<service>.Send.Threads).
+//
+// The publishing thread must wait for the shards: the events of the
+// next publish must not be queued to a subscriber before the events of
+// this one, and the subscribers to reap are returned to the topic. The
+// events and subscriber list are also owned by the caller. The send
+// threads only queue the events, the sending itself is asynchronous.
+//
+class SendThreadPool : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SendThreadPool(const Ice::LoggerPtr&, int);
+
+    // Queue the events to the subscribers, the ids of the subscribers to reap are added to the last argument.
+    void queue(bool, const EventDataSeq&, const std::vector<SubscriberPtr>&, Ice::IdentitySeq&);
+
+    void destroy();
+
+    void run(); // To be called by the send threads only.
+
+private:
+
+    struct Shard;
+
+    const Ice::LoggerPtr _logger;
+    std::vector<IceUtil::ThreadPtr> _threads;
+    std::deque<Shard*> _shards;
+    bool _destroyed;
+};
+typedef IceUtil::Handle<SendThreadPool> SendThreadPoolPtr;
+
+}
+
+#endif
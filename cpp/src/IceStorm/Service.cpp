@@ -484,13 +484,19 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "ReplicatedTopicManagerEndpoints",
         "ReplicatedPublishEndpoints",
         "Nodes.*",
+        "Shard.Name",
+        "Shards.*",
         "Transient",
         "NodeId",
+        "Flush.Adaptive",
+        "Flush.MaxSize",
         "Flush.Timeout",
         "InstanceName",
         "Election.MasterTimeout",
         "Election.ElectionTimeout",
         "Election.ResponseTimeout",
+        "Replication.ChunkSize",
+        "Replication.LogSize",
         "Publish.AdapterId",
         "Publish.Endpoints",
         "Publish.Locator",
@@ -537,7 +543,13 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Send.Timeout",
         "Send.QueueSizeMax",
         "Send.QueueSizeMaxPolicy",
+        "Send.Threads",
         "Discard.Interval",
+        "Durable.MaxSegments",
+        "Durable.Path",
+        "Durable.SegmentSize",
+        "Durable.SyncInterval",
+        "Durable.Topics",
         "LMDB.Path",
         "LMDB.MapSize"
     };
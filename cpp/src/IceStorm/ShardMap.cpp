@@ -0,0 +1,109 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/ShardMap.h>
+#include <Ice/LoggerUtil.h>
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// The number of points of each shard on the hash ring, the more points
+// the more evenly the topics are spread.
+//
+const int pointsPerShard = 128;
+
+//
+// The context of the requests forwarded to the owning shard, set to the
+// name of the forwarding shard.
+//
+const string forwardedContext = "IceStorm.ForwardedByShard";
+
+//
+// The FNV-1a hash followed by the MurmurHash3 finalizer to spread names
+// which only differ by their last characters. The topics must be
+// assigned to the same shards by all the services regardless of their
+// platform.
+//
+unsigned int
+hashName(const string& s)
+{
+    unsigned int h = 2166136261U; // Ice requires 32-bit int.
+    for(string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+        h ^= static_cast<unsigned char>(*p);
+        h *= 16777619U;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+}
+
+ShardMap::ShardMap(const string& name, const map<string, TopicManagerPrx>& shards, const TraceLevelsPtr& traceLevels) :
+    _name(name),
+    _traceLevels(traceLevels),
+    _shards(shards)
+{
+    for(map<string, TopicManagerPrx>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        for(int i = 0; i < pointsPerShard; ++i)
+        {
+            ostringstream os;
+            os << p->first << '#' << i;
+            _ring.insert(make_pair(hashName(os.str()), p->first));
+        }
+    }
+}
+
+TopicManagerPrx
+ShardMap::owner(const string& topic, const Ice::Context& context) const
+{
+    map<unsigned int, string>::const_iterator p = _ring.lower_bound(hashName(topic));
+    if(p == _ring.end())
+    {
+        p = _ring.begin();
+    }
+
+    if(p->second == _name)
+    {
+        return 0;
+    }
+
+    Ice::Context::const_iterator forwarded = context.find(forwardedContext);
+    if(forwarded != context.end())
+    {
+        //
+        // The shard which forwarded the request considers this shard as
+        // the owner of the topic: the shards aren't configured with the
+        // same shards. Forwarding the request again could loop.
+        //
+        Ice::Warning warn(_traceLevels->logger);
+        warn << "topic \"" << topic << "\" forwarded by shard `" << forwarded->second << "' is owned by shard `"
+             << p->second << "', check the shards configuration";
+        return 0;
+    }
+
+    if(_traceLevels->topicMgr > 0)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->topicMgrCat);
+        out << "topic \"" << topic << "\" is owned by shard `" << p->second << "'";
+    }
+
+    Ice::Context ctx;
+    ctx[forwardedContext] = _name;
+    return _shards.find(p->second)->second->ice_context(ctx);
+}
@@ -0,0 +1,54 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef SHARD_MAP_H
+#define SHARD_MAP_H
+
+#include <IceStorm/IceStorm.h>
+#include <IceStorm/TraceLevels.h>
+#include <map>
+
+namespace IceStorm
+{
+
+//
+// The assignment of topics to the shards of a sharded deployment. Each
+// shard is an IceStorm service or replica group with its own topics and
+// master, configured with <service>.Shard.Name and the topic manager of
+// every shard (<service>.Shards.<name>). Topics are assigned to shards
+// by consistent hashing of their name so that adding a shard only moves
+// a share of the topics to the new shard.
+//
+class ShardMap : public IceUtil::Shared
+{
+public:
+
+    ShardMap(const std::string&, const std::map<std::string, TopicManagerPrx>&, const TraceLevelsPtr&);
+
+    //
+    // Returns the topic manager of the shard owning the topic or null if
+    // this shard owns it. The returned proxy marks the requests as
+    // forwarded with its context: a request forwarded by another shard
+    // is never forwarded again, it's handled by this shard if the
+    // shards disagree on the owner of the topic.
+    //
+    TopicManagerPrx owner(const std::string&, const Ice::Context&) const;
+
+private:
+
+    const std::string _name;
+    const TraceLevelsPtr _traceLevels;
+    std::map<std::string, TopicManagerPrx> _shards;
+    std::map<unsigned int, std::string> _ring; // The shards at their points on the hash ring.
+};
+typedef IceUtil::Handle<ShardMap> ShardMapPtr;
+
+} // End namespace IceStorm
+
+#endif
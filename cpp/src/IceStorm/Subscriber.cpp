@@ -20,6 +20,8 @@ using namespace std;
 using namespace IceStorm;
 using namespace IceStormElection;
 
+const string Subscriber::multicastSequenceKey = "IceStorm.MulticastSequence";
+
 //
 // Per Subscriber object.
 //
@@ -119,6 +121,8 @@ private:
 
     const Ice::ObjectPrx _obj;
     const IceUtil::Time _interval;
+    const bool _adaptive;
+    const size_t _maxSize;
 };
 typedef IceUtil::Handle<SubscriberBatch> SubscriberBatchPtr;
 
@@ -199,7 +203,9 @@ SubscriberBatch::SubscriberBatch(
     const Ice::ObjectPrx& obj) :
     Subscriber(instance, rec, proxy, retryCount, 1),
     _obj(obj),
-    _interval(instance->flushInterval())
+    _interval(instance->flushInterval()),
+    _adaptive(instance->flushAdaptive()),
+    _maxSize(instance->flushMaxSize())
 {
     assert(retryCount == 0);
 }
@@ -207,10 +213,25 @@ SubscriberBatch::SubscriberBatch(
 void
 SubscriberBatch::flush()
 {
-    if(_outstanding == 0)
+    if(!_adaptive)
+    {
+        if(_outstanding == 0)
+        {
+            ++_outstanding;
+            _instance->batchFlusher()->schedule(new FlushTimerTask(this), _interval);
+        }
+        return;
+    }
+
+    //
+    // With adaptive flushing, the events are flushed right away if no
+    // flush is outstanding. Otherwise they are accumulated and flushed
+    // once the outstanding flush is sent.
+    //
+    while(_outstanding == 0 && !_events.empty() && _state == SubscriberStateOnline)
     {
         ++_outstanding;
-        _instance->batchFlusher()->schedule(new FlushTimerTask(this), _interval);
+        doFlush();
     }
 }
 
@@ -227,8 +248,25 @@ SubscriberBatch::doFlush()
         return;
     }
 
+    //
+    // The size of adaptive flushes is limited, the remaining events
+    // are sent with the next flush.
+    //
     EventDataSeq v;
-    v.swap(_events);
+    if(_adaptive)
+    {
+        size_t size = 0;
+        while(!_events.empty() && (v.empty() || size + _events.front()->data.size() <= _maxSize))
+        {
+            size += _events.front()->data.size();
+            v.push_back(_events.front());
+            _events.pop_front();
+        }
+    }
+    else
+    {
+        v.swap(_events);
+    }
     assert(!v.empty());
 
     if(_observer)
@@ -240,9 +278,10 @@ SubscriberBatch::doFlush()
     try
     {
         vector<Ice::Byte> dummy;
+        Ice::Context ctx;
         for(EventDataSeq::const_iterator p = v.begin(); p != v.end(); ++p)
         {
-            _obj->ice_invoke((*p)->op, (*p)->mode, (*p)->data, dummy, (*p)->context);
+            _obj->ice_invoke((*p)->op, (*p)->mode, (*p)->data, dummy, sendContext(*p, ctx));
         }
 
         Ice::AsyncResultPtr result = _obj->begin_ice_flushBatchRequests(
@@ -265,6 +304,7 @@ SubscriberBatch::doFlush()
         return;
     }
 
+    notifyQueueWaiters();
     if(_events.empty() && _outstanding == 0 && _shutdown)
     {
         _lock.notify();
@@ -346,10 +386,11 @@ SubscriberOneway::flush()
 
         try
         {
+            Ice::Context ctx;
             Ice::AsyncResultPtr result = _obj->begin_ice_invoke(
-                e->op, e->mode, e->data, e->context, Ice::newCallback_Object_ice_invoke(this,
-                                                                                        &SubscriberOneway::exception,
-                                                                                        &SubscriberOneway::sent));
+                e->op, e->mode, e->data, sendContext(e, ctx), Ice::newCallback_Object_ice_invoke(this,
+                                                                                    &SubscriberOneway::exception,
+                                                                                    &SubscriberOneway::sent));
             if(!result->sentSynchronously())
             {
                 ++_outstanding;
@@ -366,6 +407,7 @@ SubscriberOneway::flush()
         }
     }
 
+    notifyQueueWaiters();
     if(_events.empty() && _outstanding == 0 && _shutdown)
     {
         _lock.notify();
@@ -451,6 +493,7 @@ SubscriberTwoway::flush()
             return;
         }
     }
+    notifyQueueWaiters();
 }
 
 namespace
@@ -476,6 +519,7 @@ SubscriberLink::flush()
 
     EventDataSeq v;
     v.swap(_events);
+    notifyQueueWaiters();
 
     EventDataSeq::iterator p = v.begin();
     while(p != v.end())
@@ -553,10 +597,14 @@ Subscriber::create(
             {
                 reliability = p->second;
             }
-            if(!reliability.empty() && reliability != "ordered")
+            if(!reliability.empty() && reliability != "ordered" && reliability != "conflate")
             {
                 throw BadQoS("invalid reliability: " + reliability);
             }
+            if(reliability != "conflate" && rec.theQoS.find("conflationKey") != rec.theQoS.end())
+            {
+                throw BadQoS("conflationKey QoS requires conflate reliability");
+            }
 
             //
             // Override the timeout.
@@ -576,6 +624,32 @@ Subscriber::create(
                 newObj = rec.obj;
             }
 
+            //
+            // Subscribers joining a multicast group get the events sent
+            // to the group proxy instead of their own proxy.
+            //
+            p = rec.theQoS.find("multicast");
+            if(p != rec.theQoS.end())
+            {
+                Ice::ObjectPrx group;
+                try
+                {
+                    group = instance->communicator()->stringToProxy(p->second);
+                }
+                catch(const Ice::LocalException&)
+                {
+                }
+                if(!group || !(group->ice_isDatagram() || group->ice_isBatchDatagram()))
+                {
+                    throw BadQoS("invalid multicast group (datagram proxy required): " + p->second);
+                }
+                if(!reliability.empty() || rec.theQoS.find("filter") != rec.theQoS.end())
+                {
+                    throw BadQoS("multicast QoS can't be used with reliability or filter QoS");
+                }
+                newObj = group;
+            }
+
             p = rec.theQoS.find("locatorCacheTimeout");
             if(p != rec.theQoS.end())
             {
@@ -600,6 +674,17 @@ Subscriber::create(
                 newObj = newObj->ice_connectionCached(connectionCached > 0);
             }
 
+            p = rec.theQoS.find("sendQueueSizeMax");
+            if(p != rec.theQoS.end())
+            {
+                istringstream is(IceUtilInternal::trim(p->second));
+                int sendQueueSizeMax;
+                if(!(is >> sendQueueSizeMax) || !is.eof() || sendQueueSizeMax == 0 || sendQueueSizeMax < -1)
+                {
+                    throw BadQoS("invalid send queue size max (positive value or -1 required): " + p->second);
+                }
+            }
+
             if(reliability == "ordered")
             {
                 if(!newObj->ice_isTwoway())
@@ -659,6 +744,12 @@ Subscriber::record() const
     return _rec;
 }
 
+const string&
+Subscriber::multicastGroup() const
+{
+    return _multicastGroup;
+}
+
 bool
 Subscriber::queue(bool forwarded, const EventDataSeq& events)
 {
@@ -690,9 +781,20 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
+        Ice::Int queued = 0;
         for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
         {
-            if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
+            if(_filter && !_filter->match(*p))
+            {
+                continue;
+            }
+
+            if(_conflate && conflate(*p))
+            {
+                continue;
+            }
+
+            if(static_cast<int>(_events.size()) == _sendQueueSizeMax)
             {
                 if(_instance->sendQueueSizeMaxPolicy() == Instance::RemoveSubscriber)
                 {
@@ -705,11 +807,17 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
                 }
             }
             _events.push_back(*p);
+            ++queued;
+        }
+
+        if(queued == 0)
+        {
+            break;
         }
 
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(queued);
         }
         flush();
         break;
@@ -724,6 +832,48 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     return true;
 }
 
+size_t
+Subscriber::waitForQueue(size_t count)
+{
+    //
+    // Without a maximum queue size, wait for the queue to hold no more
+    // than the given number of events. The flush and state transitions
+    // notify the monitor when the queue drains. The subscriber is given
+    // the send timeout to make room for the events.
+    //
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    size_t limit = count;
+    if(_sendQueueSizeMax > 0)
+    {
+        count = min(count, static_cast<size_t>(_sendQueueSizeMax));
+        limit = static_cast<size_t>(_sendQueueSizeMax) - count;
+    }
+
+    int timeout = _instance->sendTimeout() > 0 ? _instance->sendTimeout() : 60 * 1000;
+    IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(timeout);
+    ++_queueWaiters;
+    while(_state == SubscriberStateOnline && !_shutdown && _events.size() > limit)
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(now >= deadline)
+        {
+            break;
+        }
+        _lock.timedWait(deadline - now);
+    }
+    --_queueWaiters;
+
+    //
+    // The shutdown notifications are meant for the thread waiting in
+    // shutdown(), make sure it's not missed if it woke us up instead.
+    //
+    if(_shutdown)
+    {
+        _lock.notifyAll();
+    }
+    return _state == SubscriberStateOnline && !_shutdown && _events.size() <= limit ? count : 0;
+}
+
 bool
 Subscriber::reap()
 {
@@ -974,11 +1124,16 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(EventFilter::create(rec.theQoS)),
+    _conflate(false),
+    _sendQueueSizeMax(instance->sendQueueSizeMax()),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
-    _currentRetry(0)
+    _queueWaiters(0),
+    _currentRetry(0),
+    _multicastSequence(0)
 {
     if(_proxy && _instance->publisherReplicaProxy())
     {
@@ -986,6 +1141,30 @@ Subscriber::Subscriber(
             _instance->publisherReplicaProxy()->ice_identity(_proxy->ice_getIdentity());
     }
 
+    QoS::const_iterator p = rec.theQoS.find("multicast");
+    if(p != rec.theQoS.end())
+    {
+        Ice::CommunicatorPtr communicator = _instance->communicator();
+        const_cast<string&>(_multicastGroup) = communicator->proxyToString(communicator->stringToProxy(p->second));
+    }
+
+    p = rec.theQoS.find("reliability");
+    if(p != rec.theQoS.end() && p->second == "conflate")
+    {
+        const_cast<bool&>(_conflate) = true;
+        p = rec.theQoS.find("conflationKey");
+        if(p != rec.theQoS.end())
+        {
+            const_cast<string&>(_conflationKey) = p->second;
+        }
+    }
+
+    p = rec.theQoS.find("sendQueueSizeMax");
+    if(p != rec.theQoS.end())
+    {
+        const_cast<int&>(_sendQueueSizeMax) = atoi(p->second.c_str());
+    }
+
     if(_instance->observer())
     {
         _observer.attach(_instance->observer()->getSubscriberObserver(_instance->serviceName(),
@@ -1034,6 +1213,7 @@ Subscriber::setState(Subscriber::SubscriberState state)
                 << " transition from: " << stateToString(_state) << " to: " << stateToString(state);
         }
         _state = state;
+        notifyQueueWaiters();
 
         if(_instance->observer())
         {
@@ -1048,6 +1228,76 @@ Subscriber::setState(Subscriber::SubscriberState state)
     }
 }
 
+void
+Subscriber::notifyQueueWaiters()
+{
+    if(_queueWaiters > 0)
+    {
+        _lock.notifyAll();
+    }
+}
+
+bool
+Subscriber::conflate(const EventDataPtr& event)
+{
+    //
+    // Events are conflated if they have the same operation and the
+    // same value for the conflation key, if any. The queue holds at
+    // most one event per key so it remains short even if the
+    // subscriber can't keep up.
+    //
+    const string* key = 0;
+    if(!_conflationKey.empty())
+    {
+        Ice::Context::const_iterator p = event->context.find(_conflationKey);
+        if(p == event->context.end())
+        {
+            return false; // Events without the key are never conflated.
+        }
+        key = &p->second;
+    }
+
+    for(EventDataSeq::iterator p = _events.begin(); p != _events.end(); ++p)
+    {
+        if((*p)->op != event->op)
+        {
+            continue;
+        }
+
+        if(key)
+        {
+            Ice::Context::const_iterator q = (*p)->context.find(_conflationKey);
+            if(q == (*p)->context.end() || q->second != *key)
+            {
+                continue;
+            }
+        }
+
+        *p = event;
+        return true;
+    }
+    return false;
+}
+
+const Ice::Context&
+Subscriber::sendContext(const EventDataPtr& event, Ice::Context& ctx)
+{
+    //
+    // Events sent to a multicast group are numbered so that the group
+    // members can detect lost events.
+    //
+    if(_multicastGroup.empty())
+    {
+        return event->context;
+    }
+
+    ctx = event->context;
+    ostringstream os;
+    os << ++_multicastSequence;
+    ctx[multicastSequenceKey] = os.str();
+    return ctx;
+}
+
 bool
 IceStorm::operator==(const SubscriberPtr& subscriber, const Ice::Identity& id)
 {
@@ -1071,3 +1321,148 @@ IceStorm::operator<(const Subscriber& s1, const Subscriber& s2)
 {
     return &s1 < &s2;
 }
+
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    QoS::const_iterator p = qos.find("filter");
+    if(p == qos.end())
+    {
+        return 0;
+    }
+
+    EventFilterPtr filter = new EventFilter;
+    vector<string> clauses;
+    if(!IceUtilInternal::splitString(p->second, ";", clauses))
+    {
+        throw BadQoS("invalid filter (unmatched quote): " + p->second);
+    }
+    for(vector<string>::const_iterator q = clauses.begin(); q != clauses.end(); ++q)
+    {
+        string clause = IceUtilInternal::trim(*q);
+        if(clause.empty())
+        {
+            continue;
+        }
+
+        string::size_type pos = clause.find_first_of(" \t=!(");
+        if(pos == string::npos)
+        {
+            throw BadQoS("invalid filter clause (missing operator): " + clause);
+        }
+        string key = clause.substr(0, pos);
+        string rest = IceUtilInternal::trim(clause.substr(pos));
+
+        Clause c;
+        if(key == "op")
+        {
+            c.key = "";
+        }
+        else if(key.size() > 4 && key.compare(0, 4, "ctx.") == 0)
+        {
+            c.key = key.substr(4);
+        }
+        else
+        {
+            throw BadQoS("invalid filter clause (expected `op' or `ctx.<key>'): " + clause);
+        }
+
+        vector<string> values;
+        if(rest.compare(0, 2, "!=") == 0)
+        {
+            c.negate = true;
+            values.push_back(IceUtilInternal::trim(rest.substr(2)));
+        }
+        else if(rest.compare(0, 1, "=") == 0)
+        {
+            c.negate = false;
+            values.push_back(IceUtilInternal::trim(rest.substr(1)));
+        }
+        else if(rest.compare(0, 2, "in") == 0)
+        {
+            c.negate = false;
+            rest = IceUtilInternal::trim(rest.substr(2));
+            if(rest.size() < 2 || rest[0] != '(' || rest[rest.size() - 1] != ')')
+            {
+                throw BadQoS("invalid filter clause (expected `in (<value>, ...)'): " + clause);
+            }
+            IceUtilInternal::splitString(rest.substr(1, rest.size() - 2), ",", values);
+            if(values.empty())
+            {
+                throw BadQoS("invalid filter clause (missing value): " + clause);
+            }
+        }
+        else
+        {
+            throw BadQoS("invalid filter clause (expected `=', `!=' or `in'): " + clause);
+        }
+
+        for(vector<string>::const_iterator v = values.begin(); v != values.end(); ++v)
+        {
+            string value = IceUtilInternal::trim(*v);
+            if(value.empty())
+            {
+                throw BadQoS("invalid filter clause (missing value): " + clause);
+            }
+            c.values.insert(value);
+        }
+        filter->_clauses.push_back(c);
+    }
+
+    if(filter->_clauses.empty())
+    {
+        throw BadQoS("invalid filter (no clause): " + p->second);
+    }
+    return filter;
+}
+
+bool
+EventFilter::match(const EventDataPtr& event) const
+{
+    for(vector<Clause>::const_iterator p = _clauses.begin(); p != _clauses.end(); ++p)
+    {
+        bool found;
+        if(p->key.empty())
+        {
+            found = p->values.find(event->op) != p->values.end();
+        }
+        else
+        {
+            Ice::Context::const_iterator q = event->context.find(p->key);
+            found = q != event->context.end() && p->values.find(q->second) != p->values.end();
+        }
+
+        if(found == p->negate)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+
+vector<SubscriberPtr>
+senders(const vector<SubscriberPtr>& subscribers)
+{
+    vector<SubscriberPtr> result;
+    result.reserve(subscribers.size());
+    set<string> groups;
+    for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        const string& group = (*p)->multicastGroup();
+        if(group.empty() || groups.insert(group).second)
+        {
+            result.push_back(*p);
+        }
+    }
+    return result;
+}
+
+}
+
+SubscriberList::SubscriberList(const vector<SubscriberPtr>& s) :
+    subscribers(senders(s))
+{
+}
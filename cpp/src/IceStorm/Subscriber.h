@@ -15,6 +15,7 @@
 #include <IceStorm/Instrumentation.h>
 #include <Ice/ObserverHelper.h>
 #include <IceUtil/RecMutex.h>
+#include <set>
 
 namespace IceStorm
 {
@@ -25,6 +26,39 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+//
+// The filter of a subscriber, compiled from the "filter" QoS. The
+// filter is a list of clauses separated by semicolons, all of which
+// must match for the event to be sent to the subscriber. A clause
+// compares the event operation (op) or a context value (ctx.<key>)
+// with `=', `!=' or `in (<value>, ...)', for example:
+//
+// op in (tick, quote); ctx.region = eu
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    // Returns null if the QoS has no filter, throws BadQoS if the filter is invalid.
+    static EventFilterPtr create(const IceStorm::QoS&);
+
+    bool match(const EventDataPtr&) const;
+
+private:
+
+    struct Clause
+    {
+        std::string key; // The context key, empty for the operation.
+        bool negate;
+        std::set<std::string> values;
+    };
+
+    std::vector<Clause> _clauses;
+};
+
 class Subscriber : public IceUtil::Shared
 {
 public:
@@ -34,9 +68,14 @@ public:
     Ice::ObjectPrx proxy() const; // Get the per subscriber object.
     Ice::Identity id() const; // Return the id of the subscriber.
     IceStorm::SubscriberRecord record() const; // Get the subscriber record.
+    const std::string& multicastGroup() const; // Get the multicast group of the subscriber, if any.
 
     // Returns false if the subscriber should be reaped.
     bool queue(bool, const EventDataSeq&);
+
+    // Wait for the queue to have room for up to the given number of events, returns the number of events which
+    // can be queued or 0 if the subscriber isn't online or if the queue didn't drain within the send timeout.
+    size_t waitForQueue(size_t);
     bool reap();
     void resetIfReaped();
     bool errored() const;
@@ -61,9 +100,14 @@ public:
 
     virtual void flush() = 0;
 
+    static const std::string multicastSequenceKey; // The event context key for the multicast sequence number.
+
 protected:
 
     void setState(SubscriberState);
+    void notifyQueueWaiters();
+    bool conflate(const EventDataPtr&);
+    const Ice::Context& sendContext(const EventDataPtr&, Ice::Context&);
 
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
@@ -74,6 +118,11 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The filter of the events to send, if any.
+    const bool _conflate; // Do queued events get replaced by newer events with the same key?
+    const std::string _conflationKey; // The context key of the events to conflate, if any.
+    const std::string _multicastGroup; // The multicast group proxy, if any.
+    const int _sendQueueSizeMax; // The maximum number of queued events, -1 if unlimited.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -84,14 +133,33 @@ protected:
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
+    int _queueWaiters; // The number of threads waiting for the queue to drain.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
     int _currentRetry;
 
+    Ice::Long _multicastSequence; // The sequence number of the last event sent to the multicast group.
+
     IceInternal::ObserverHelperT<IceStorm::Instrumentation::SubscriberObserver> _observer;
 };
 
+//
+// An immutable copy of a topic's subscriber list. Publishers share the
+// same copy until the subscriber list is updated. Only the first
+// subscriber of each multicast group is included, it sends the events
+// to the group on behalf of the others.
+//
+class SubscriberList : public IceUtil::Shared
+{
+public:
+
+    SubscriberList(const std::vector<SubscriberPtr>&);
+
+    const std::vector<SubscriberPtr> subscribers;
+};
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
 bool operator==(const IceStorm::SubscriberPtr&, const Ice::Identity&);
 bool operator==(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
 bool operator!=(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
@@ -10,11 +10,14 @@
 #include <IceStorm/TopicI.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/SendThreadPool.h>
+#include <IceStorm/EventLog.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/StringUtil.h>
 #include <algorithm>
 
 using namespace std;
@@ -32,6 +35,50 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+//
+// The maximum number of logged events replayed to a subscriber at once.
+//
+const size_t replayBatchSize = 1000;
+
+//
+// The maximum number of replays without the subscribers mutex locked
+// for the subscriber to catch up with the publishers.
+//
+const int maxReplayRounds = 10;
+
+//
+// Replay the logged events to the subscriber until the given sequence
+// number, or until the end of the log if it's 0. If wait is true, each
+// batch waits for the subscriber's queue to have room for it. Returns
+// false if the subscriber is no longer online or if its queue didn't
+// drain in time.
+//
+bool
+replayEvents(const EventLogPtr& log, EventLog::Position& position, Ice::Long end, const SubscriberPtr& subscriber,
+             bool wait)
+{
+    while(end == 0 || position.seq < end)
+    {
+        size_t count = wait ? subscriber->waitForQueue(replayBatchSize) : replayBatchSize;
+        if(count == 0)
+        {
+            return false;
+        }
+
+        EventDataSeq events;
+        log->read(position, count, events);
+        if(!events.empty() && !subscriber->queue(false, events))
+        {
+            return false;
+        }
+        if(events.size() < count)
+        {
+            break;
+        }
+    }
+    return true;
+}
+
 //
 // The servant has a 1-1 association with a topic. It is used to
 // receive events from Publishers.
@@ -358,6 +405,8 @@ TopicImpl::TopicImpl(
         // non-replicated case we could allocate a null-topic impl here.
         _servant = new TopicI(this, instance);
 
+        _eventLog = _instance->createEventLog(_name);
+
         //
         // Create a servant per topic to receive event data. If the
         // category is empty then we are in backwards compatibility
@@ -414,6 +463,7 @@ TopicImpl::TopicImpl(
                 //
                 SubscriberPtr subscriber = Subscriber::create(_instance, *p);
                 _subscribers.push_back(subscriber);
+                _subscribersCopy = 0;
             }
             catch(const Ice::Exception& ex)
             {
@@ -546,9 +596,85 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
         throw AlreadySubscribed();
     }
 
+    //
+    // With a durable topic, the subscriber can ask for the logged events
+    // starting with the given sequence number.
+    //
+    Ice::Long resumeFrom = 0;
+    QoS::const_iterator q = qos.find("resumeFrom");
+    if(q != qos.end())
+    {
+        if(!_eventLog)
+        {
+            throw BadQoS("resumeFrom requires a durable topic");
+        }
+        if(qos.find("multicast") != qos.end())
+        {
+            throw BadQoS("resumeFrom can't be used with multicast QoS");
+        }
+        istringstream is(IceUtilInternal::trim(q->second));
+        if(!(is >> resumeFrom) || !is.eof() || resumeFrom < 1)
+        {
+            throw BadQoS("invalid resumeFrom sequence number (positive numeric value required): " + q->second);
+        }
+    }
+
     LogUpdate llu;
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
+
+    if(resumeFrom > 0)
+    {
+        //
+        // The logged events are replayed without the subscribers mutex
+        // locked so that publishers aren't blocked, in batches paced by
+        // the subscriber's queue. The replay is repeated until the
+        // subscriber is within one batch of the end of the log, only
+        // these last events are replayed once the mutex is locked again.
+        //
+        EventLogPtr eventLog = _eventLog;
+        EventLog::Position position(resumeFrom);
+        const Ice::Long batchSize = static_cast<Ice::Long>(replayBatchSize);
+        sync.release();
+        bool online = true;
+        Ice::Long end = eventLog->next();
+        for(int i = 0; online && i < maxReplayRounds && end - position.seq > batchSize; ++i)
+        {
+            online = replayEvents(eventLog, position, end, subscriber, true);
+            end = eventLog->next();
+        }
+        sync.acquire();
+
+        if(_destroyed)
+        {
+            subscriber->destroy();
+            throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+        }
+        if(find(_subscribers.begin(), _subscribers.end(), record.id) != _subscribers.end())
+        {
+            subscriber->destroy();
+            throw AlreadySubscribed();
+        }
+
+        //
+        // Don't add a subscriber which missed some of the logged events,
+        // either because it didn't accept them or because it can't keep
+        // up with the publishers.
+        //
+        if(!online || eventLog->next() - position.seq > batchSize ||
+           !replayEvents(eventLog, position, 0, subscriber, false))
+        {
+            subscriber->destroy();
+            if(traceLevels->topic > 0)
+            {
+                Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+                out << _name << ": subscribe: " << _instance->communicator()->identityToString(id)
+                    << ": replay of the logged events from " << resumeFrom << " failed";
+            }
+            throw InvalidSubscriber("couldn't replay the logged events to the subscriber");
+        }
+    }
+
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -570,6 +696,7 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     }
 
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 
@@ -682,6 +809,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
     }
 
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 
     _instance->observers()->addSubscriber(llu, _name, record);
 }
@@ -760,6 +888,12 @@ TopicImpl::shutdown()
         (*p)->shutdown();
     }
 
+    if(_eventLog)
+    {
+        _instance->timer()->cancel(_eventLog);
+        _eventLog->close();
+    }
+
     _observer.detach();
 }
 
@@ -870,6 +1004,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
             {
                 (*p)->destroy();
                 p = _subscribers.erase(p);
+                _subscribersCopy = 0;
             }
             else
             {
@@ -894,6 +1029,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
         {
             SubscriberPtr subscriber = Subscriber::create(_instance, *p);
             _subscribers.push_back(subscriber);
+            _subscribersCopy = 0;
         }
     }
 }
@@ -971,9 +1107,10 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
 
         //
         // Copy of the subscriber list so that event publishing can occur
-        // in parallel.
+        // in parallel. The copy is shared with other publishers until the
+        // subscriber list is updated.
         //
-        vector<SubscriberPtr> copy;
+        SubscriberListPtr copy;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -987,20 +1124,28 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                     _observer->published();
                 }
             }
-            copy = _subscribers;
+            if(!_subscribersCopy)
+            {
+                _subscribersCopy = new SubscriberList(_subscribers);
+            }
+            copy = _subscribersCopy;
+
+            //
+            // The events are logged while the subscribers mutex is locked
+            // so that new subscribers replaying the log don't miss or get
+            // twice the events being published.
+            //
+            if(_eventLog)
+            {
+                _eventLog->append(events);
+            }
         }
 
         //
         // Queue each event, gathering a list of those subscribers that
         // must be reaped.
         //
-        for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
-        {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
-            {
-                reap.push_back((*p)->id());
-            }
-        }
+        _instance->sendThreadPool()->queue(forwarded, events, copy->subscribers, reap);
 
         // If there are no subscribers in error then we're done.
         if(reap.empty())
@@ -1095,6 +1240,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
     }
 
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 }
 
 void
@@ -1153,6 +1299,7 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
         {
             (*p)->destroy();
             _subscribers.erase(p);
+            _subscribersCopy = 0;
         }
     }
 }
@@ -1260,11 +1407,19 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _subscribersCopy = 0;
 
     _instance->topicAdapter()->remove(_id);
 
     _servant = 0;
 
+    if(_eventLog)
+    {
+        _instance->timer()->cancel(_eventLog);
+        _eventLog->destroy();
+        _eventLog = 0;
+    }
+
     return llu;
 }
 
@@ -1322,6 +1477,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
             {
                 (*p)->destroy();
                 _subscribers.erase(p);
+                _subscribersCopy = 0;
             }
         }
 
@@ -27,6 +27,12 @@ typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberList;
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
 class TopicImpl : public IceUtil::Shared
 {
 public:
@@ -87,6 +93,8 @@ private:
 
     Ice::ObjectPtr _servant; // The topic implementation servant.
 
+    EventLogPtr _eventLog; // The event log if the topic is durable.
+
     // Mutex protecting the subscribers.
     IceUtil::Mutex _subscribersMutex;
 
@@ -99,6 +107,12 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    //
+    // The subscriber list shared by publishers, reset whenever
+    // _subscribers is updated.
+    //
+    SubscriberListPtr _subscribersCopy;
+
     bool _destroyed; // Has this Topic been destroyed?
 
     LLUMap _lluMap;
@@ -15,6 +15,7 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/Subscriber.h>
 #include <IceStorm/Util.h>
+#include <IceStorm/ShardMap.h>
 #include <Ice/SliceChecksums.h>
 
 #include <functional>
@@ -34,6 +35,12 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+//
+// The number of times a replica retrieves the topic content pages
+// again before retrieving the whole content at once.
+//
+const int maxContentRestarts = 3;
+
 class TopicManagerI : public TopicManagerInternal
 {
 public:
@@ -43,8 +50,14 @@ public:
     {
     }
 
-    virtual TopicPrx create(const string& id, const Ice::Current&)
+    virtual TopicPrx create(const string& id, const Ice::Current& current)
     {
+        TopicManagerPrx owner = getShard(id, current);
+        if(owner)
+        {
+            return owner->create(id);
+        }
+
         while(true)
         {
             Ice::Long generation;
@@ -53,7 +66,7 @@ public:
             {
                 try
                 {
-                    return master->create(id);
+                    return master->create(id, current.ctx); // Keep the forwarded context of the shards.
                 }
                 catch(const Ice::ConnectFailedException&)
                 {
@@ -74,8 +87,14 @@ public:
         }
     }
 
-    virtual TopicPrx retrieve(const string& id, const Ice::Current&) const
+    virtual TopicPrx retrieve(const string& id, const Ice::Current& current) const
     {
+        TopicManagerPrx owner = getShard(id, current);
+        if(owner)
+        {
+            return owner->retrieve(id);
+        }
+
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
         return _impl->retrieve(id);
@@ -102,6 +121,12 @@ public:
 
 private:
 
+    TopicManagerPrx getShard(const string& id, const Ice::Current& current) const
+    {
+        ShardMapPtr shards = _instance->shards();
+        return shards ? shards->owner(id, current.ctx) : TopicManagerPrx();
+    }
+
     TopicManagerPrx getMaster(Ice::Long& generation, const char* file, int line) const
     {
         NodeIPtr node = _instance->node();
@@ -139,6 +164,26 @@ public:
         _impl->observerInit(llu, content);
     }
 
+    virtual void initChunk(const LogUpdate& llu, const TopicContentSeq& content, const Ice::Current&)
+    {
+        NodeIPtr node = _instance->node();
+        if(node)
+        {
+            node->checkObserverInit(llu.generation);
+        }
+        _impl->observerInitChunk(llu, content);
+    }
+
+    virtual void initUpdates(const LogUpdate& llu, const TopicUpdateSeq& updates, const Ice::Current&)
+    {
+        NodeIPtr node = _instance->node();
+        if(node)
+        {
+            node->checkObserverInit(llu.generation);
+        }
+        _impl->observerInitUpdates(llu, updates);
+    }
+
     virtual void createTopic(const LogUpdate& llu, const string& name, const Ice::Current&)
     {
         try
@@ -225,6 +270,17 @@ public:
         _impl->getContent(llu, content);
     }
 
+    virtual bool getContentPage(const IceUtil::Optional<string>& after, LogUpdate& llu, TopicContentSeq& content,
+                                const Ice::Current&)
+    {
+        return _impl->getContentPage(after, llu, content);
+    }
+
+    virtual bool getUpdates(const LogUpdate& from, LogUpdate& llu, TopicUpdateSeq& updates, const Ice::Current&)
+    {
+        return _impl->getUpdates(from, llu, updates);
+    }
+
 private:
 
     const TopicManagerImplPtr _impl;
@@ -239,6 +295,10 @@ TopicManagerImpl::TopicManagerImpl(const PersistentInstancePtr& instance) :
 {
     try
     {
+        Ice::PropertiesPtr properties = _instance->communicator()->getProperties();
+        _chunkSize = static_cast<size_t>(
+            max(properties->getPropertyAsIntWithDefault(_instance->serviceName() + ".Replication.ChunkSize", 1000), 1));
+
         __setNoDelete(true);
 
         if(_instance->observer())
@@ -389,10 +449,19 @@ TopicManagerImpl::retrieveAll() const
 }
 
 void
-TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& content)
+TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& chunk)
 {
     Lock sync(*this);
 
+    // Add the last chunk to the chunks sent before init.
+    TopicContentSeq content;
+    if(llu == _initLLU)
+    {
+        content.swap(_initContent);
+    }
+    _initContent.clear();
+    content.insert(content.end(), chunk.begin(), chunk.end());
+
     TraceLevelsPtr traceLevels = _instance->traceLevels();
     if(traceLevels->topicMgr > 0)
     {
@@ -502,6 +571,81 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
             p->second->update(q->records);
         }
     }
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->reset(llu);
+    }
+
+    // Clear the set of observers.
+    _instance->observers()->clear();
+}
+
+void
+TopicManagerImpl::observerInitChunk(const LogUpdate& llu, const TopicContentSeq& content)
+{
+    Lock sync(*this);
+
+    if(llu != _initLLU)
+    {
+        _initLLU = llu;
+        _initContent.clear();
+    }
+    _initContent.insert(_initContent.end(), content.begin(), content.end());
+}
+
+void
+TopicManagerImpl::observerInitUpdates(const LogUpdate& llu, const TopicUpdateSeq& updates)
+{
+    Lock sync(*this);
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topicMgr > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicMgrCat);
+        out << "init with " << updates.size() << " missed updates";
+    }
+
+    _initContent.clear();
+
+    for(TopicUpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+    {
+        switch(p->kind)
+        {
+        case TopicUpdateCreateTopic:
+            observerCreateTopic(p->llu, p->name);
+            break;
+        case TopicUpdateDestroyTopic:
+            observerDestroyTopic(p->llu, p->name);
+            break;
+        case TopicUpdateAddSubscriber:
+            observerAddSubscriber(p->llu, p->name, p->record);
+            break;
+        case TopicUpdateRemoveSubscriber:
+            observerRemoveSubscriber(p->llu, p->name, p->subscribers);
+            break;
+        }
+    }
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+        _lluMap.put(txn, lluDbKey, llu);
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
+    }
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->setLast(llu);
+    }
+
     // Clear the set of observers.
     _instance->observers()->clear();
 }
@@ -539,6 +683,12 @@ TopicManagerImpl::observerCreateTopic(const LogUpdate& llu, const string& name)
     }
 
     installTopic(name, id, true);
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->createTopic(llu, name);
+    }
 }
 
 void
@@ -554,6 +704,12 @@ TopicManagerImpl::observerDestroyTopic(const LogUpdate& llu, const string& name)
     q->second->observerDestroyTopic(llu);
 
     _topics.erase(q);
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->destroyTopic(llu, name);
+    }
 }
 
 void
@@ -572,6 +728,12 @@ TopicManagerImpl::observerAddSubscriber(const LogUpdate& llu, const string& name
         topic = q->second;
     }
     topic->observerAddSubscriber(llu, record);
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->addSubscriber(llu, name, record);
+    }
 }
 
 void
@@ -590,27 +752,68 @@ TopicManagerImpl::observerRemoveSubscriber(const LogUpdate& llu, const string& n
         topic = q->second;
     }
     topic->observerRemoveSubscriber(llu, id);
+
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    if(updateLog)
+    {
+        updateLog->removeSubscriber(llu, name, id);
+    }
 }
 
 void
 TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
 {
+    Lock sync(*this);
+    reap();
+
+    try
     {
-        Lock sync(*this);
-        reap();
+        content.clear();
+        for(map<string, TopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
+        {
+            content.push_back(p->second->getContent());
+        }
+
+        IceDB::ReadOnlyTxn txn(_instance->dbEnv());
+        _lluMap.get(txn, lluDbKey, llu);
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        throw; // will become UnknownException in caller
     }
+}
+
+bool
+TopicManagerImpl::getContentPage(const IceUtil::Optional<string>& after, LogUpdate& llu, TopicContentSeq& content)
+{
+    Lock sync(*this);
+    reap();
 
     try
     {
         content.clear();
-        for(map<string, TopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
+
+        //
+        // The pages are delimited by topic name rather than position,
+        // topics created or destroyed between two calls change the llu
+        // and the caller starts again.
+        //
+        map<string, TopicImplPtr>::const_iterator p = after ? _topics.upper_bound(*after) : _topics.begin();
+
+        size_t records = 0;
+        while(p != _topics.end() && records < _chunkSize)
         {
             TopicContent rec = p->second->getContent();
+            records += rec.records.size() + 1;
             content.push_back(rec);
+            ++p;
         }
 
         IceDB::ReadOnlyTxn txn(_instance->dbEnv());
         _lluMap.get(txn, lluDbKey, llu);
+
+        return p != _topics.end();
     }
     catch(const IceDB::LMDBException& ex)
     {
@@ -619,6 +822,16 @@ TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
     }
 }
 
+bool
+TopicManagerImpl::getUpdates(const LogUpdate& from, LogUpdate& llu, TopicUpdateSeq& updates)
+{
+    Lock sync(*this);
+
+    llu = getLastLogUpdate();
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    return updateLog && updateLog->get(from, updates);
+}
+
 LogUpdate
 TopicManagerImpl::getLastLogUpdate() const
 {
@@ -640,12 +853,81 @@ TopicManagerImpl::getLastLogUpdate() const
 void
 TopicManagerImpl::sync(const Ice::ObjectPrx& master)
 {
-    TopicManagerSyncPrx sync = TopicManagerSyncPrx::uncheckedCast(master);
+    TopicManagerSyncPrx topicManagerSync = TopicManagerSyncPrx::uncheckedCast(master);
 
+    //
+    // Only get the updates we missed if they are still available,
+    // otherwise get the topic content in pages. A master from a
+    // previous version only supports retrieving the whole content.
+    //
     LogUpdate llu;
+    TopicUpdateSeq updates;
+    try
+    {
+        if(topicManagerSync->getUpdates(getLastLogUpdate(), llu, updates))
+        {
+            observerInitUpdates(llu, updates);
+            return;
+        }
+    }
+    catch(const Ice::OperationNotExistException&)
+    {
+    }
+
+    //
+    // The content is retrieved in pages to bound the size of the
+    // messages, it's still assembled here before the observer is
+    // initialized. If the master content changed while the pages were
+    // retrieved, the content is retrieved again from the first topic.
+    // After too many restarts, the whole content is retrieved at once
+    // so that a busy master doesn't keep the replica from syncing.
+    //
     TopicContentSeq content;
-    sync->getContent(llu, content);
+    try
+    {
+        int restarts = 0;
+        bool more;
+        do
+        {
+            LogUpdate pageLlu;
+            TopicContentSeq page;
+            IceUtil::Optional<string> after;
+            if(!content.empty())
+            {
+                after = identityToTopicName(content.back().id);
+            }
+            more = topicManagerSync->getContentPage(after, pageLlu, page);
+            if(!content.empty() && pageLlu != llu)
+            {
+                TraceLevelsPtr traceLevels = _instance->traceLevels();
+                if(traceLevels->replication > 0)
+                {
+                    Ice::Trace out(traceLevels->logger, traceLevels->replicationCat);
+                    out << "master content updated while retrieving it, retrieving it again";
+                }
+                content.clear();
+                if(++restarts > maxContentRestarts)
+                {
+                    topicManagerSync->getContent(llu, content);
+                    break;
+                }
+                more = true;
+                continue;
+            }
+            llu = pageLlu;
+            content.insert(content.end(), page.begin(), page.end());
+        }
+        while(more);
+    }
+    catch(const Ice::OperationNotExistException&)
+    {
+        topicManagerSync->getContent(llu, content);
+    }
 
+    {
+        Lock sync(*this);
+        _initContent.clear();
+    }
     observerInit(llu, content);
 }
 
@@ -656,7 +938,27 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
 
     reap();
 
-    TopicContentSeq content;
+    //
+    // The slaves which are recent enough are sent the updates they
+    // missed, the others are sent the topic content.
+    //
+    UpdateLogPtr updateLog = _instance->observers()->updateLog();
+    map<int, TopicUpdateSeq> updates;
+    bool sendContent = false;
+    for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p)
+    {
+        TopicUpdateSeq missed;
+        if(updateLog && updateLog->get(p->llu, missed))
+        {
+            updates[p->id].swap(missed);
+        }
+        else
+        {
+            sendContent = true;
+        }
+    }
+
+    vector<TopicContentSeq> content;
 
     // Update the database llu. This prevents the following case:
     //
@@ -671,14 +973,23 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
     //
     try
     {
-        content.clear();
-
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
-        for(map<string, TopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
+        if(sendContent)
         {
-            TopicContent rec = p->second->getContent();
-            content.push_back(rec);
+            content.push_back(TopicContentSeq());
+            size_t records = 0;
+            for(map<string, TopicImplPtr>::const_iterator p = _topics.begin(); p != _topics.end(); ++p)
+            {
+                if(records >= _chunkSize)
+                {
+                    content.push_back(TopicContentSeq());
+                    records = 0;
+                }
+                TopicContent rec = p->second->getContent();
+                records += rec.records.size() + 1;
+                content.back().push_back(rec);
+            }
         }
 
         _lluMap.put(txn, lluDbKey, llu);
@@ -691,8 +1002,13 @@ TopicManagerImpl::initMaster(const set<GroupNodeInfo>& slaves, const LogUpdate&
         throw; // will become UnknownException in caller
     }
 
+    if(updateLog)
+    {
+        updateLog->setLast(llu);
+    }
+
     // Now initialize the observers.
-    _instance->observers()->init(slaves, llu, content);
+    _instance->observers()->init(slaves, llu, updates, content);
 }
 
 Ice::ObjectPrx
@@ -49,6 +49,8 @@ public:
 
     // Observer methods.
     void observerInit(const IceStormElection::LogUpdate&, const IceStormElection::TopicContentSeq&);
+    void observerInitChunk(const IceStormElection::LogUpdate&, const IceStormElection::TopicContentSeq&);
+    void observerInitUpdates(const IceStormElection::LogUpdate&, const IceStormElection::TopicUpdateSeq&);
     void observerCreateTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerDestroyTopic(const IceStormElection::LogUpdate&, const std::string&);
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const std::string&,
@@ -57,6 +59,10 @@ public:
 
     // Sync methods.
     void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
+    bool getContentPage(const IceUtil::Optional<std::string>&, IceStormElection::LogUpdate&,
+                        IceStormElection::TopicContentSeq&);
+    bool getUpdates(const IceStormElection::LogUpdate&, IceStormElection::LogUpdate&,
+                    IceStormElection::TopicUpdateSeq&);
 
     // Replica methods.
     virtual IceStormElection::LogUpdate getLastLogUpdate() const;
@@ -91,6 +97,10 @@ private:
 
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+
+    size_t _chunkSize; // The number of subscribers sent per chunk of topic content.
+    IceStormElection::LogUpdate _initLLU;
+    IceStormElection::TopicContentSeq _initContent; // The chunks received before init.
 };
 typedef IceUtil::Handle<TopicManagerImpl> TopicManagerImplPtr;
 
@@ -10,6 +10,7 @@
 #include <IceStorm/TransientTopicI.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/SendThreadPool.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/Util.h>
 
@@ -259,6 +260,7 @@ TransientTopicImpl::subscribe(const QoS& origQoS, const Ice::ObjectPrx& obj, con
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 }
 
 Ice::ObjectPrx
@@ -315,6 +317,7 @@ TransientTopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPr
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 
     return subscriber->proxy();
 }
@@ -354,6 +357,7 @@ TransientTopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber, const Ice::Cur
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _subscribersCopy = 0;
     }
 }
 
@@ -401,6 +405,7 @@ TransientTopicImpl::link(const TopicPrx& topic, Ice::Int cost, const Ice::Curren
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
     _subscribers.push_back(subscriber);
+    _subscribersCopy = 0;
 }
 
 void
@@ -445,6 +450,7 @@ TransientTopicImpl::unlink(const TopicPrx& topic, const Ice::Current&)
     {
         (*p)->destroy();
         _subscribers.erase(p);
+        _subscribersCopy = 0;
     }
 }
 
@@ -515,6 +521,7 @@ TransientTopicImpl::destroy(const Ice::Current&)
         (*p)->destroy();
     }
     _subscribers.clear();
+    _subscribersCopy = 0;
 }
 
 void
@@ -541,12 +548,17 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
 {
     //
     // Copy of the subscriber list so that event publishing can occur
-    // in parallel.
+    // in parallel. The copy is shared with other publishers until the
+    // subscriber list is updated.
     //
-    vector<SubscriberPtr> copy;
+    SubscriberListPtr copy;
     {
         Lock sync(*this);
-        copy = _subscribers;
+        if(!_subscribersCopy)
+        {
+            _subscribersCopy = new SubscriberList(_subscribers);
+        }
+        copy = _subscribersCopy;
     }
 
     //
@@ -554,13 +566,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
     // must be reaped.
     //
     vector<Ice::Identity> e;
-    for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
-    {
-        if(!(*p)->queue(forwarded, events) && (*p)->reap())
-        {
-            e.push_back((*p)->id());
-        }
-    }
+    _instance->sendThreadPool()->queue(forwarded, events, copy->subscribers, e);
 
     //
     // Run through the error list removing those subscribers that are
@@ -594,6 +600,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
                 //
                 subscriber->destroy();
                 _subscribers.erase(q);
+                _subscribersCopy = 0;
             }
         }
     }
@@ -22,6 +22,9 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberList;
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
 class TransientTopicImpl : public TopicInternal, public IceUtil::Mutex
 {
 public:
@@ -71,6 +74,12 @@ private:
     //
     std::vector<SubscriberPtr> _subscribers;
 
+    //
+    // The subscriber list shared by publishers, reset whenever
+    // _subscribers is updated.
+    //
+    SubscriberListPtr _subscribersCopy;
+
     bool _destroyed; // Has this Topic been destroyed?
 };
 
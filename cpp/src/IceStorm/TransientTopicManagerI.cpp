@@ -12,6 +12,7 @@
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/ShardMap.h>
 
 #include <Ice/Ice.h>
 
@@ -32,8 +33,15 @@ TransientTopicManagerImpl::~TransientTopicManagerImpl()
 }
 
 TopicPrx
-TransientTopicManagerImpl::create(const string& name, const Ice::Current&)
+TransientTopicManagerImpl::create(const string& name, const Ice::Current& current)
 {
+    ShardMapPtr shards = _instance->shards();
+    TopicManagerPrx owner = shards ? shards->owner(name, current.ctx) : TopicManagerPrx();
+    if(owner)
+    {
+        return owner->create(name);
+    }
+
     Lock sync(*this);
 
     reap();
@@ -72,8 +80,15 @@ TransientTopicManagerImpl::create(const string& name, const Ice::Current&)
 }
 
 TopicPrx
-TransientTopicManagerImpl::retrieve(const string& name, const Ice::Current&) const
+TransientTopicManagerImpl::retrieve(const string& name, const Ice::Current& current) const
 {
+    ShardMapPtr shards = _instance->shards();
+    TopicManagerPrx owner = shards ? shards->owner(name, current.ctx) : TopicManagerPrx();
+    if(owner)
+    {
+        return owner->retrieve(name);
+    }
+
     Lock sync(*this);
 
     TransientTopicManagerImpl* This = const_cast<TransientTopicManagerImpl*>(this);
@@ -0,0 +1,148 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceStorm/UpdateLog.h>
+
+using namespace std;
+using namespace IceStormElection;
+
+UpdateLog::UpdateLog(size_t max) :
+    _max(max)
+{
+    //
+    // The replica state at startup isn't known, log updates from the
+    // generation 0 are never used to find the missing updates.
+    //
+    _base.generation = 0;
+    _base.iteration = 0;
+    _last = _base;
+}
+
+void
+UpdateLog::reset(const LogUpdate& llu)
+{
+    Lock sync(*this);
+    _updates.clear();
+    _base = llu;
+    _last = llu;
+}
+
+void
+UpdateLog::setLast(const LogUpdate& llu)
+{
+    Lock sync(*this);
+    _last = llu;
+}
+
+void
+UpdateLog::createTopic(const LogUpdate& llu, const string& name)
+{
+    TopicUpdate update;
+    update.llu = llu;
+    update.kind = TopicUpdateCreateTopic;
+    update.name = name;
+    append(update);
+}
+
+void
+UpdateLog::destroyTopic(const LogUpdate& llu, const string& name)
+{
+    TopicUpdate update;
+    update.llu = llu;
+    update.kind = TopicUpdateDestroyTopic;
+    update.name = name;
+    append(update);
+}
+
+void
+UpdateLog::addSubscriber(const LogUpdate& llu, const string& name, const IceStorm::SubscriberRecord& record)
+{
+    TopicUpdate update;
+    update.llu = llu;
+    update.kind = TopicUpdateAddSubscriber;
+    update.name = name;
+    update.record = record;
+    append(update);
+}
+
+void
+UpdateLog::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& subscribers)
+{
+    TopicUpdate update;
+    update.llu = llu;
+    update.kind = TopicUpdateRemoveSubscriber;
+    update.name = name;
+    update.subscribers = subscribers;
+    append(update);
+}
+
+bool
+UpdateLog::get(const LogUpdate& from, TopicUpdateSeq& updates) const
+{
+    Lock sync(*this);
+
+    updates.clear();
+    if(from.generation == 0 || _last < from)
+    {
+        return false;
+    }
+    else if(from == _last)
+    {
+        return true;
+    }
+
+    deque<TopicUpdate>::const_iterator p = _updates.begin();
+    while(p != _updates.end() && !(from < p->llu))
+    {
+        ++p;
+    }
+    if(p == _updates.end())
+    {
+        return false;
+    }
+
+    //
+    // The given log update must either be the log update of an update
+    // from the log or the start of the generation of the next update,
+    // otherwise the replica has updates that this replica doesn't
+    // have.
+    //
+    bool found = p == _updates.begin() ? from == _base : (p - 1)->llu == from;
+    if(!found && from.iteration == 0)
+    {
+        found = p->llu.generation == from.generation && p->llu.iteration == 1;
+    }
+    if(!found)
+    {
+        return false;
+    }
+
+    updates.insert(updates.end(), p, _updates.end());
+    return true;
+}
+
+void
+UpdateLog::append(const TopicUpdate& update)
+{
+    Lock sync(*this);
+    if(_max == 0)
+    {
+        _base = update.llu;
+    }
+    else
+    {
+        _updates.push_back(update);
+        while(_updates.size() > _max)
+        {
+            _base = _updates.front().llu;
+            _updates.pop_front();
+        }
+    }
+    _last = update.llu;
+}
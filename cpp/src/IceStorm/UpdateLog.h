@@ -0,0 +1,67 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef UPDATE_LOG_H
+#define UPDATE_LOG_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <IceStorm/Election.h>
+#include <deque>
+
+namespace IceStormElection
+{
+
+//
+// The last updates applied to the topics of a replica. It's used to
+// send a replica only the updates it missed instead of the content of
+// all the topics. The log holds at most the given number of updates,
+// the oldest updates are discarded first.
+//
+class UpdateLog : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    UpdateLog(size_t);
+
+    // Discard the updates, the replica state matches the given log update.
+    void reset(const LogUpdate&);
+
+    // Set the last log update without changing the replica state (a new generation started).
+    void setLast(const LogUpdate&);
+
+    // Add an update to the log.
+    void createTopic(const LogUpdate&, const std::string&);
+    void destroyTopic(const LogUpdate&, const std::string&);
+    void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
+    void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+
+    //
+    // Get the updates following the given log update. Returns false if
+    // the updates are not available, either because they have been
+    // discarded or because the given log update isn't part of the
+    // history of this replica.
+    //
+    bool get(const LogUpdate&, TopicUpdateSeq&) const;
+
+private:
+
+    void append(const TopicUpdate&);
+
+    const size_t _max;
+
+    std::deque<TopicUpdate> _updates;
+    LogUpdate _base; // The log update before the first update.
+    LogUpdate _last;
+};
+typedef IceUtil::Handle<UpdateLog> UpdateLogPtr;
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <IceUtil/MutexPtrLock.h>
 #include <IceUtil/Mutex.h>
 #include <IceUtil/StringUtil.h>
+#include <cstring>
 
 #ifdef ICE_HAS_CODECVT_UTF8
 #include <codecvt>
@@ -34,6 +35,36 @@ IceUtil::WstringConverterPtr processWstringConverter;
 IceUtil::WstringConverterPtr unicodeWstringConverter;
 #endif
 
+//
+// Copies the leading ASCII characters of [sourceStart, sourceEnd) to target
+// and returns the position of the first non-ASCII byte. Most strings are
+// plain ASCII, their conversion doesn't need to go through the UTF-8 decoder.
+// The bytes are checked 8 at a time when possible.
+//
+const Byte*
+widenASCII(const Byte* sourceStart, const Byte* sourceEnd, wchar_t*& target)
+{
+    const Byte* p = sourceStart;
+    while(sourceEnd - p >= 8)
+    {
+        IceUtil::Int64 word;
+        memcpy(&word, p, sizeof(word));
+        if(word & ICE_INT64(0x8080808080808080))
+        {
+            break;
+        }
+        for(int i = 0; i < 8; ++i)
+        {
+            *target++ = static_cast<wchar_t>(*p++);
+        }
+    }
+    while(p != sourceEnd && *p < 0x80)
+    {
+        *target++ = static_cast<wchar_t>(*p++);
+    }
+    return p;
+}
+
 #ifdef ICE_HAS_CODECVT_UTF8
 
 template<size_t wcharSize>
@@ -163,19 +194,27 @@ public:
             wchar_t* targetEnd = targetStart + sourceSize;
             wchar_t* targetNext = targetStart;
 
-            const char* sourceNext = reinterpret_cast<const char*>(sourceStart);
+            //
+            // Only the remainder following the leading ASCII characters is converted with codecvt.
+            //
+            sourceStart = widenASCII(sourceStart, sourceEnd, targetNext);
+            if(sourceStart != sourceEnd)
+            {
+                wchar_t* targetNextASCII = targetNext;
+                const char* sourceNext = reinterpret_cast<const char*>(sourceStart);
 
-            mbstate_t state = mbstate_t();
+                mbstate_t state = mbstate_t();
 
-            codecvt_base::result result = _codecvt.in(state,
-                                                      reinterpret_cast<const char*>(sourceStart),
-                                                      reinterpret_cast<const char*>(sourceEnd),
-                                                      sourceNext,
-                                                      targetStart, targetEnd, targetNext);
+                codecvt_base::result result = _codecvt.in(state,
+                                                          reinterpret_cast<const char*>(sourceStart),
+                                                          reinterpret_cast<const char*>(sourceEnd),
+                                                          sourceNext,
+                                                          targetNextASCII, targetEnd, targetNext);
 
-            if(result != codecvt_base::ok)
-            {
-                throw IllegalConversionException(__FILE__, __LINE__, "codecvt.in failure");
+                if(result != codecvt_base::ok)
+                {
+                    throw IllegalConversionException(__FILE__, __LINE__, "codecvt.in failure");
+                }
             }
 
             target.resize(targetNext - targetStart);
@@ -231,7 +270,20 @@ public:
         }
         else
         {
-            convertUTF8ToUTFWstring(sourceStart, sourceEnd, target);
+            //
+            // Only the remainder following the leading ASCII characters is converted with
+            // convertUTF8ToUTFWstring.
+            //
+            target.resize(sourceEnd - sourceStart);
+            wchar_t* targetNext = const_cast<wchar_t*>(target.data());
+            const Byte* sourceNext = widenASCII(sourceStart, sourceEnd, targetNext);
+            if(sourceNext != sourceEnd)
+            {
+                target.resize(sourceNext - sourceStart);
+                wstring remainder;
+                convertUTF8ToUTFWstring(sourceNext, sourceEnd, remainder);
+                target += remainder;
+            }
         }
     }
 };
@@ -564,6 +616,31 @@ IceUtilInternal::fromUTF32(const vector<unsigned int>& source)
 
 namespace
 {
+
+bool
+isASCII(const Byte* sourceStart, const Byte* sourceEnd)
+{
+    const Byte* p = sourceStart;
+    while(sourceEnd - p >= 8)
+    {
+        IceUtil::Int64 word;
+        memcpy(&word, p, sizeof(word));
+        if(word & ICE_INT64(0x8080808080808080))
+        {
+            return false;
+        }
+        p += 8;
+    }
+    while(p != sourceEnd)
+    {
+        if(*p++ >= 0x80)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 //
 // Converts to/from UTF-8 using MultiByteToWideChar and WideCharToMultiByte
 //
@@ -579,11 +656,35 @@ public:
 
 private:
     unsigned int _cp;
+    bool _asciiCompatible; // True if the code page encodes the ASCII characters as ASCII.
 };
 
 WindowsStringConverter::WindowsStringConverter(unsigned int cp) :
-    _cp(cp)
+    _cp(cp),
+    _asciiCompatible(false)
 {
+    //
+    // The ANSI and OEM code pages encode ASCII as ASCII, UTF-7 and the
+    // EBCDIC code pages don't.
+    //
+    wchar_t wascii[128];
+    char ascii[128];
+    for(int i = 0; i < 128; ++i)
+    {
+        wascii[i] = static_cast<wchar_t>(i);
+    }
+    if(WideCharToMultiByte(_cp, 0, wascii, 128, ascii, 128, 0, 0) == 128)
+    {
+        _asciiCompatible = true;
+        for(int i = 0; i < 128; ++i)
+        {
+            if(ascii[i] != static_cast<char>(i))
+            {
+                _asciiCompatible = false;
+                break;
+            }
+        }
+    }
 }
 
 Byte*
@@ -639,7 +740,11 @@ WindowsStringConverter::fromUTF8(const Byte* sourceStart, const Byte* sourceEnd,
         return;
     }
 
-    if(_cp == CP_UTF8)
+    //
+    // ASCII strings, the most common strings, are copied as is if the
+    // code page is ASCII compatible.
+    //
+    if(_cp == CP_UTF8 || (_asciiCompatible && isASCII(sourceStart, sourceEnd)))
     {
         string tmp(reinterpret_cast<const char*>(sourceStart), sourceEnd - sourceStart);
         tmp.swap(target);
@@ -79,6 +79,62 @@ isConstexprType(const TypePtr& type)
     }
 }
 
+//
+// Returns true if the struct's data members are all byte, short, int, long,
+// float or double values, or structs that satisfy the same condition. If the
+// C++ struct has no padding, sequences of such structs can be marshaled with
+// a single copy (see IsBulkStreamable).
+//
+bool
+isBulkStreamable(const StructPtr& p)
+{
+    DataMemberList members = p->dataMembers();
+    for(DataMemberList::const_iterator i = members.begin(); i != members.end(); ++i)
+    {
+        BuiltinPtr bp = BuiltinPtr::dynamicCast((*i)->type());
+        if(bp)
+        {
+            switch(bp->kind())
+            {
+                case Builtin::KindByte:
+                case Builtin::KindShort:
+                case Builtin::KindInt:
+                case Builtin::KindLong:
+                case Builtin::KindFloat:
+                case Builtin::KindDouble:
+                {
+                    break;
+                }
+                default:
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            StructPtr st = StructPtr::dynamicCast((*i)->type());
+            if(!st || findMetaData(st->getMetaData(), false) == "%class" || !isBulkStreamable(st))
+            {
+                return false;
+            }
+        }
+    }
+    return !members.empty();
+}
+
+void
+writeBulkStreamableTraits(IceUtilInternal::Output& out, const StructPtr& p, const string& name)
+{
+    if(isBulkStreamable(p))
+    {
+        out << nl << "template<>";
+        out << nl << "struct IsBulkStreamable< " << name << ">";
+        out << sb;
+        out << nl << "static const bool value = sizeof(" << name << ") == " << p->minWireSize() << ";";
+        out << eb << ";" << nl;
+    }
+}
 
 string
 getDeprecateSymbol(const ContainedPtr& p1, const ContainedPtr& p2)
@@ -4470,6 +4526,11 @@ Slice::Gen::StreamVisitor::visitStructStart(const StructPtr& p)
         }
         H << eb << ";" << nl;
 
+        if(!classMetaData)
+        {
+            writeBulkStreamableTraits(H, p, fullStructName);
+        }
+
         writeStreamHelpers(H, p, p->dataMembers(), false, true, false);
     }
     return false;
@@ -7599,6 +7660,8 @@ Slice::Gen::Cpp11StreamVisitor::visitStructStart(const StructPtr& p)
     H << nl << "static const bool fixedLength = " << (p->isVariableLength() ? "false" : "true") << ";";
     H << eb << ";" << nl;
 
+    writeBulkStreamableTraits(H, p, scoped);
+
     writeStreamHelpers(H, p, p->dataMembers(), false, false, true);
 
     return false;
@@ -787,6 +787,33 @@ run(int, char**, const Ice::CommunicatorPtr& communicator)
 #endif
     }
 
+    {
+        PointS arr;
+        for(int i = 0; i < 4; ++i)
+        {
+            Point pt;
+            pt.x = i;
+            pt.y = -i;
+            arr.push_back(pt);
+        }
+        Ice::OutputStream out(communicator);
+        out.write(arr);
+        out.finished(data);
+        test(data.size() == 1 + arr.size() * 16);
+        Ice::InputStream in(communicator, data);
+        PointS arr2;
+        in.read(arr2);
+        test(arr2 == arr);
+
+        PointS empty;
+        Ice::OutputStream out2(communicator);
+        out2.write(empty);
+        out2.finished(data);
+        Ice::InputStream in2(communicator, data);
+        in2.read(arr2);
+        test(arr2.empty());
+    }
+
     {
         MyClassS arr;
         for(int i = 0; i < 4; ++i)
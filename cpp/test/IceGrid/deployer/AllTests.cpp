@@ -372,6 +372,48 @@ logTests(const Ice::CommunicatorPtr& comm, const AdminSessionPrx& session)
         test(false);
     }
 
+    try
+    {
+        //
+        // Test with two iterators polling the end of a file written
+        // between their reads.
+        //
+        string path = testDir + "/log5.txt";
+        ofstream os(path.c_str(), ios_base::out | ios_base::trunc);
+        os << flush;
+
+        FileIteratorPrx it1 = session->openServerLog("LogServer", path, -1);
+        FileIteratorPrx it2 = session->openServerLog("LogServer", path, -1);
+        test(it1->read(1024, lines) && lines.empty());
+        test(it2->read(1024, lines) && lines.empty());
+
+        os << "first line" << endl;
+        test(it1->read(1024, lines) && lines.size() == 2 && lines[0] == "first line" && lines[1].empty());
+        test(it1->read(1024, lines) && lines.empty());
+
+        os << "second line" << endl;
+        test(it2->read(1024, lines) && lines.size() == 3);
+        test(lines[0] == "first line" && lines[1] == "second line" && lines[2].empty());
+        test(it2->read(1024, lines) && lines.empty());
+        test(it1->read(1024, lines) && lines.size() == 2 && lines[0] == "second line" && lines[1].empty());
+        test(it1->read(1024, lines) && lines.empty());
+        test(it2->read(1024, lines) && lines.empty());
+
+        os << "third line" << endl;
+        test(it1->read(1024, lines) && lines.size() == 2 && lines[0] == "third line" && lines[1].empty());
+        test(it2->read(1024, lines) && lines.size() == 2 && lines[0] == "third line" && lines[1].empty());
+        test(it1->read(1024, lines) && lines.empty());
+        test(it2->read(1024, lines) && lines.empty());
+
+        it1->destroy();
+        it2->destroy();
+    }
+    catch(const FileNotAvailableException& ex)
+    {
+        cerr << ex.reason << endl;
+        test(false);
+    }
+
     cout << "ok" << endl;
 }
 
@@ -101,6 +101,28 @@ removeServer(const AdminPrx& admin, const string& id)
     }
 }
 
+bool
+waitForActiveServers(const AdminPrx& admin, const vector<string>& ids, int count)
+{
+    for(int i = 0; i < 200; ++i)
+    {
+        int active = 0;
+        for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+        {
+            if(admin->getServerState(*p) == IceGrid::Active)
+            {
+                ++active;
+            }
+        }
+        if(active == count)
+        {
+            return true;
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+    }
+    return false;
+}
+
 void
 allTests(const Ice::CommunicatorPtr& comm)
 {
@@ -480,6 +502,81 @@ allTests(const Ice::CommunicatorPtr& comm)
     }
     cout << "ok" << endl;
 
+    cout << "testing replication with dispatch load balancing... " << flush;
+    {
+        map<string, string> params;
+        params["replicaGroup"] = "Dispatch";
+        params["id"] = "Server1";
+        instantiateServer(admin, "Server", "localnode", params);
+        params["id"] = "Server2";
+        instantiateServer(admin, "Server", "localnode", params);
+
+        TestIntfPrx server1 = TestIntfPrx::uncheckedCast(comm->stringToProxy("Server1"));
+        TestIntfPrx server2 = TestIntfPrx::uncheckedCast(comm->stringToProxy("Server2"));
+        test(server1->getReplicaId() == "Server1.ReplicatedAdapter");
+        test(server2->getReplicaId() == "Server2.ReplicatedAdapter");
+
+        //
+        // The node collects the dispatch metrics of the servers every
+        // second, the latency is computed from the requests completed
+        // between two samples. Keep Server1 busy with short requests
+        // until the replica group resolves to Server2: the registry
+        // then has the load of both servers.
+        //
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(comm->stringToProxy("Dispatch"));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(0));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(30);
+        Ice::AsyncResultPtr result;
+        int resolved = 0;
+        while(resolved < 10)
+        {
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) < deadline);
+            if(!result || result->isCompleted())
+            {
+                if(result)
+                {
+                    server1->end_sleep(result);
+                }
+                result = server1->begin_sleep(500);
+            }
+            try
+            {
+                resolved = obj->getReplicaId() == "Server2.ReplicatedAdapter" ? resolved + 1 : 0;
+            }
+            catch(const Ice::LocalException& ex)
+            {
+                cerr << ex << endl;
+                test(false);
+            }
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        }
+
+        //
+        // A request is kept dispatching on Server1 while the replica
+        // group is resolved.
+        //
+        server1->end_sleep(result);
+        result = server1->begin_sleep(8000);
+        for(int i = 0; i < 20; ++i)
+        {
+            try
+            {
+                test(obj->getReplicaId() == "Server2.ReplicatedAdapter");
+            }
+            catch(const Ice::LocalException& ex)
+            {
+                cerr << ex << endl;
+                test(false);
+            }
+        }
+
+        server1->end_sleep(result);
+        removeServer(admin, "Server1");
+        removeServer(admin, "Server2");
+    }
+    cout << "ok" << endl;
+
     cout << "testing filters... " << flush;
     {
         map<string, string> params;
@@ -1068,5 +1165,73 @@ allTests(const Ice::CommunicatorPtr& comm)
         removeServer(admin, "Server3");
     }
     cout << "ok" << endl;
+
+    cout << "testing warm pool... " << flush;
+    {
+        //
+        // The registry keeps 2 replicas of the Warm replica group active,
+        // the servers are deployed without being started.
+        //
+        vector<string> ids;
+        NodeUpdateDescriptor nodeUpdate;
+        nodeUpdate.name = "localnode";
+        for(int i = 1; i <= 3; ++i)
+        {
+            ostringstream os;
+            os << "Server" << i;
+            ids.push_back(os.str());
+
+            ServerInstanceDescriptor desc;
+            desc._cpp_template = "Server";
+            desc.parameterValues["id"] = os.str();
+            desc.parameterValues["replicaGroup"] = "Warm";
+            nodeUpdate.serverInstances.push_back(desc);
+        }
+        ApplicationUpdateDescriptor update;
+        update.name = "Test";
+        update.nodes.push_back(nodeUpdate);
+        admin->updateApplication(update);
+
+        test(waitForActiveServers(admin, ids, 2));
+
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(comm->stringToProxy("Warm"));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(0));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+        obj->getReplicaId();
+
+        //
+        // Stopping a replica with the admin interface refills the pool
+        // with the inactive replica, the stopped replica stays inactive,
+        // including when the pool is checked again by the registry timer.
+        //
+        string stopped;
+        string inactive;
+        for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+        {
+            if(admin->getServerState(*p) == IceGrid::Active)
+            {
+                if(stopped.empty())
+                {
+                    stopped = *p;
+                }
+            }
+            else
+            {
+                inactive = *p;
+            }
+        }
+        test(!stopped.empty() && !inactive.empty());
+        admin->stopServer(stopped);
+        test(waitForActiveServers(admin, ids, 2));
+        test(admin->getServerState(stopped) == IceGrid::Inactive);
+        test(admin->getServerState(inactive) == IceGrid::Active);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(6));
+        test(admin->getServerState(stopped) == IceGrid::Inactive);
+
+        removeServer(admin, "Server1");
+        removeServer(admin, "Server2");
+        removeServer(admin, "Server3");
+    }
+    cout << "ok" << endl;
     session->destroy();
 }
@@ -10,7 +10,12 @@
 
 registryProps = {
     "Ice.Plugin.RegistryPlugin" : "RegistryPlugin:createRegistryPlugin",
-    "IceGrid.Registry.DynamicRegistration" : 1
+    "IceGrid.Registry.DynamicRegistration" : 1,
+    "IceGrid.Registry.WarmPool.Warm" : 2
+}
+
+nodeProps = {
+    "IceGrid.Node.DispatchMetricsView" : "Dispatch"
 }
 
 clientProps = {
@@ -19,6 +24,7 @@ clientProps = {
 
 TestSuite(__file__,
           [IceGridTestCase(icegridregistry=[IceGridRegistryMaster(props=registryProps)],
+                           icegridnode=IceGridNode(props=nodeProps),
                            client=IceGridClient(props=clientProps))],
           libDirs=["registryplugin", "testservice"],
           multihost=False)
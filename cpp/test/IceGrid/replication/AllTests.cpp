@@ -244,6 +244,38 @@ createAdminSession(const Ice::LocatorPrx& locator, const string& replica)
     return session->getAdmin();
 }
 
+bool
+hasLine(const Ice::StringSeq& lines, const string& text)
+{
+    for(Ice::StringSeq::const_iterator p = lines.begin(); p != lines.end(); ++p)
+    {
+        if(p->find(text) != string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// Read the lines written to the file of the iterator until one of the
+// lines read contains the given text.
+//
+void
+waitForLine(const FileIteratorPrx& it, Ice::StringSeq& lines, const string& text)
+{
+    int nRetry = 0;
+    while(!hasLine(lines, text))
+    {
+        test(++nRetry < maxRetry);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(sleepTime));
+
+        Ice::StringSeq read;
+        it->read(64 * 1024, read);
+        lines.insert(lines.end(), read.begin(), read.end());
+    }
+}
+
 }
 
 void
@@ -277,6 +309,8 @@ allTests(const Ice::CommunicatorPtr& comm)
     params["id"] = "Slave2";
     params["replicaName"] = "Slave2";
     params["port"] = "12052";
+    params["traceReplica"] = "1";
+    params["stderr"] = "${node.data}/Slave2.err";
     instantiateServer(admin, "IceGridRegistry", params);
 
     Ice::LocatorPrx masterLocator =
@@ -583,6 +617,14 @@ allTests(const Ice::CommunicatorPtr& comm)
         test(slave1Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
         test(slave2Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
 
+        test(masterLocator->findAdapterById("TestAdpt") == adpt.proxy);
+        test(slave1Locator->findAdapterById("TestAdpt") == adpt.proxy);
+        test(slave2Locator->findAdapterById("TestAdpt") == adpt.proxy);
+
+        test(masterLocator->findObjectById(obj.proxy->ice_getIdentity()) == obj.proxy);
+        test(slave1Locator->findObjectById(obj.proxy->ice_getIdentity()) == obj.proxy);
+        test(slave2Locator->findObjectById(obj.proxy->ice_getIdentity()) == obj.proxy);
+
         slave2Admin->shutdown();
         waitForServerState(admin, "Slave2", false);
 
@@ -658,6 +700,9 @@ allTests(const Ice::CommunicatorPtr& comm)
         test(slave1Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
         test(slave2Admin->getObjectInfo(obj.proxy->ice_getIdentity()) == obj);
 
+        test(slave1Locator->findObjectById(obj.proxy->ice_getIdentity()) == obj.proxy);
+        test(slave2Locator->findObjectById(obj.proxy->ice_getIdentity()) == obj.proxy);
+
         slave2Admin->shutdown();
         waitForServerState(admin, "Slave2", false);
 
@@ -770,8 +815,118 @@ allTests(const Ice::CommunicatorPtr& comm)
         {
         }
 
+        try
+        {
+            slave1Locator->findAdapterById("TestAdpt");
+            test(false);
+        }
+        catch(const Ice::AdapterNotFoundException&)
+        {
+        }
+        try
+        {
+            slave2Locator->findObjectById(obj.proxy->ice_getIdentity());
+            test(false);
+        }
+        catch(const Ice::ObjectNotFoundException&)
+        {
+        }
+
+        slave2Admin->shutdown();
+        waitForServerState(admin, "Slave2", false);
+    }
+    cout << "ok" << endl;
+
+    //
+    // Missed updates test:
+    //
+    // - shutdown slave2, apply fewer updates than the replication log
+    //   size (10 updates): slave2 gets the logged updates when it
+    //   reconnects
+    // - shutdown slave2, apply more updates than the replication log
+    //   size: the log no longer has the updates following the slave2
+    //   serials, slave2 gets the full database
+    //
+    // The sync of slave2 is checked with its replica traces: it only
+    // initializes its database with the master content when it gets
+    // the full database.
+    //
+    cout << "testing replication of missed updates... " << flush;
+    {
+        Ice::LocatorRegistryPrx locatorRegistry = slave1Locator->getRegistry();
+
+        ApplicationDescriptor app;
+        app.name = "TestApp";
+        app.description = "added application";
+        masterAdmin->addApplication(app);
+        ApplicationUpdateDescriptor appUpdate;
+        appUpdate.name = "TestApp";
+        appUpdate.description = new BoxedString("updated application");
+        masterAdmin->updateApplication(appUpdate);
+
+        vector<string> adapterIds;
+        for(int i = 0; i < 5; ++i)
+        {
+            ostringstream os;
+            os << "MissedAdpt" << i;
+            adapterIds.push_back(os.str());
+            locatorRegistry->setAdapterDirectProxy(os.str(), comm->stringToProxy("dummy:tcp -p 12345 -h 127.0.0.1"));
+        }
+
+        FileIteratorPrx stdErr = session->openServerStdErr("Slave2", 0);
+        admin->startServer("Slave2");
+        slave2Admin = createAdminSession(slave2Locator, "Slave2");
+        test(slave2Admin->getApplicationInfo("TestApp").descriptor.description == "updated application");
+        for(vector<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+        {
+            test(slave2Admin->getAdapterInfo(*p)[0] == masterAdmin->getAdapterInfo(*p)[0]);
+        }
+        Ice::StringSeq lines;
+        waitForLine(stdErr, lines, "established session with master replica");
+        test(!hasLine(lines, "initializing database with"));
+        stdErr->destroy();
+        slave2Admin->shutdown();
+        waitForServerState(admin, "Slave2", false);
+
+        for(int i = 0; i < 15; ++i)
+        {
+            ostringstream os;
+            os << "MissedAdpt" << i;
+            if(i >= 5)
+            {
+                adapterIds.push_back(os.str());
+            }
+            locatorRegistry->setAdapterDirectProxy(os.str(), comm->stringToProxy("dummy:tcp -p 12346 -h 127.0.0.1"));
+        }
+        for(int i = 0; i < 12; ++i)
+        {
+            ostringstream os;
+            os << "updated application " << i;
+            appUpdate.description = new BoxedString(os.str());
+            masterAdmin->updateApplication(appUpdate);
+        }
+
+        stdErr = session->openServerStdErr("Slave2", 0);
+        admin->startServer("Slave2");
+        slave2Admin = createAdminSession(slave2Locator, "Slave2");
+        test(slave2Admin->getApplicationInfo("TestApp").descriptor.description == "updated application 11");
+        for(vector<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+        {
+            test(slave2Admin->getAdapterInfo(*p)[0] == masterAdmin->getAdapterInfo(*p)[0]);
+            test(slave2Locator->findAdapterById(*p) == comm->stringToProxy("dummy:tcp -p 12346 -h 127.0.0.1"));
+        }
+        lines.clear();
+        waitForLine(stdErr, lines, "applications from master replica");
+        waitForLine(stdErr, lines, "adapters from master replica");
+        stdErr->destroy();
         slave2Admin->shutdown();
         waitForServerState(admin, "Slave2", false);
+
+        masterAdmin->removeApplication("TestApp");
+        for(vector<string>::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+        {
+            masterAdmin->removeAdapter(*p);
+        }
     }
     cout << "ok" << endl;
 
@@ -99,18 +99,32 @@ protected:
 };
 map<string, ObserverBase*> ObserverBase::_observers;
 
+Ice::Long
+getDatabaseSerial(const Ice::Context& context, Ice::Long dbSerial)
+{
+    Ice::Context::const_iterator p = context.find("dbSerial");
+    if(p != context.end())
+    {
+        istringstream is(p->second);
+        is >> dbSerial;
+    }
+    return dbSerial;
+}
+
 class ApplicationObserverI : public ApplicationObserver, public ObserverBase
 {
 public:
 
-    ApplicationObserverI(const string& name) : ObserverBase(name)
+    ApplicationObserverI(const string& name) : ObserverBase(name), serial(0), dbSerial(0), inits(0)
     {
     }
 
     virtual void
-    applicationInit(int serial, const ApplicationInfoSeq& apps, const Ice::Current&)
+    applicationInit(int serial, const ApplicationInfoSeq& apps, const Ice::Current& current)
     {
         Lock sync(*this);
+        ++this->inits;
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         for(ApplicationInfoSeq::const_iterator p = apps.begin(); p != apps.end(); ++p)
         {
             if(p->descriptor.name != "Test") // Ignore the test application from application.xml!
@@ -122,25 +136,28 @@ public:
     }
 
     virtual void
-    applicationAdded(int serial, const ApplicationInfo& app, const Ice::Current&)
+    applicationAdded(int serial, const ApplicationInfo& app, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         this->applications.insert(make_pair(app.descriptor.name, app));
         updated(updateSerial(serial, "application added `" + app.descriptor.name + "'"));
     }
 
     virtual void
-    applicationRemoved(int serial, const std::string& name, const Ice::Current&)
+    applicationRemoved(int serial, const std::string& name, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         this->applications.erase(name);
         updated(updateSerial(serial, "application removed `" + name + "'"));
     }
 
     virtual void
-    applicationUpdated(int serial, const ApplicationUpdateInfo& info, const Ice::Current&)
+    applicationUpdated(int serial, const ApplicationUpdateInfo& info, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         const ApplicationUpdateDescriptor& desc = info.descriptor;
         for(Ice::StringSeq::const_iterator q = desc.removeVariables.begin(); q != desc.removeVariables.end(); ++q)
         {
@@ -154,6 +171,8 @@ public:
     }
 
     int serial;
+    Ice::Long dbSerial;
+    int inits;
     map<string, ApplicationInfo> applications;
 
 private:
@@ -173,14 +192,17 @@ class AdapterObserverI : public AdapterObserver, public ObserverBase
 {
 public:
 
-    AdapterObserverI(const string& name) : ObserverBase(name)
+    AdapterObserverI(const string& name) : ObserverBase(name), dbSerial(0), inits(0), initSize(0), _hold(false)
     {
     }
 
     virtual void
-    adapterInit(const AdapterInfoSeq& adapters, const Ice::Current&)
+    adapterInit(const AdapterInfoSeq& adapters, const Ice::Current& current)
     {
         Lock sync(*this);
+        ++this->inits;
+        this->initSize = adapters.size();
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         for(AdapterInfoSeq::const_iterator q = adapters.begin(); q != adapters.end(); ++q)
         {
             this->adapters.insert(make_pair(q->id, *q));
@@ -189,30 +211,51 @@ public:
     }
 
     void
-    adapterAdded(const AdapterInfo& info, const Ice::Current&)
+    adapterAdded(const AdapterInfo& info, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         this->adapters.insert(make_pair(info.id, info));
         updated(updateSerial(0, "adapter added `" + info.id + "'"));
+        while(_hold)
+        {
+            wait();
+        }
     }
 
     void
-    adapterUpdated(const AdapterInfo& info, const Ice::Current&)
+    adapterUpdated(const AdapterInfo& info, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         this->adapters[info.id] = info;
         updated(updateSerial(0, "adapter updated `" + info.id + "'"));
     }
 
     void
-    adapterRemoved(const string& id, const Ice::Current&)
+    adapterRemoved(const string& id, const Ice::Current& current)
     {
         Lock sync(*this);
+        this->dbSerial = getDatabaseSerial(current.ctx, this->dbSerial);
         this->adapters.erase(id);
         updated(updateSerial(0, "adapter removed `" + id + "'"));
     }
 
+    //
+    // While held, the observer doesn't return from adapterAdded.
+    //
+    void
+    hold(bool value)
+    {
+        Lock sync(*this);
+        _hold = value;
+        notifyAll();
+    }
+
     int serial;
+    Ice::Long dbSerial;
+    int inits;
+    size_t initSize;
     map<string, AdapterInfo> adapters;
 
 private:
@@ -225,6 +268,8 @@ private:
         os << update << " (serial = " << serial << ")";
         return os.str();
     }
+
+    bool _hold;
 };
 typedef IceUtil::Handle<AdapterObserverI> AdapterObserverIPtr;
 
@@ -1530,6 +1575,139 @@ allTests(const Ice::CommunicatorPtr& communicator)
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing application observer with database serial... " << flush;
+        Ice::ObjectAdapterPtr adpt1 = communicator->createObjectAdapter("");
+        adpt1->activate();
+        registry->ice_getConnection()->setAdapter(adpt1);
+
+        AdminSessionPrx session1 = registry->createAdminSession("admin1", "test1");
+        session1->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+        ApplicationObserverIPtr appObs1 = new ApplicationObserverI("appObs1.3");
+        Ice::ObjectPrx app1 = adpt1->addWithUUID(appObs1);
+        session1->setObserversByIdentity(Ice::Identity(),
+                                         Ice::Identity(),
+                                         app1->ice_getIdentity(),
+                                         Ice::Identity(),
+                                         Ice::Identity());
+        appObs1->waitForUpdate(__FILE__, __LINE__); // init
+        int serial = appObs1->serial;
+        Ice::Long dbSerial = appObs1->dbSerial;
+        session1->destroy();
+
+        //
+        // Updates made while the observer isn't registered are sent to
+        // the observer which provides the serial of its database, each
+        // update with the serial it was published with.
+        //
+        try
+        {
+            ApplicationDescriptor app;
+            app.name = "Resume1";
+            admin->addApplication(app);
+            app.name = "Resume2";
+            admin->addApplication(app);
+            ApplicationUpdateDescriptor update;
+            update.name = "Resume1";
+            update.variables["test"] = "test";
+            admin->updateApplication(update);
+        }
+        catch(const Ice::UserException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+
+        Ice::Context ctx;
+        {
+            ostringstream os;
+            os << dbSerial;
+            ctx["dbSerial.applications"] = os.str();
+        }
+        AdminSessionPrx session2 = registry->createAdminSession("admin1", "test1");
+        session2->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+        ApplicationObserverIPtr appObs2 = new ApplicationObserverI("appObs2.3");
+        Ice::ObjectPrx app2 = adpt1->addWithUUID(appObs2);
+        session2->setObserversByIdentity(Ice::Identity(),
+                                         Ice::Identity(),
+                                         app2->ice_getIdentity(),
+                                         Ice::Identity(),
+                                         Ice::Identity(),
+                                         ctx);
+        appObs2->waitForUpdate(__FILE__, __LINE__);
+        test(appObs2->serial == ++serial);
+        test(appObs2->applications.find("Resume1") != appObs2->applications.end());
+        appObs2->waitForUpdate(__FILE__, __LINE__);
+        test(appObs2->serial == ++serial);
+        test(appObs2->applications.find("Resume2") != appObs2->applications.end());
+        appObs2->waitForUpdate(__FILE__, __LINE__);
+        test(appObs2->serial == ++serial);
+        test(appObs2->applications["Resume1"].descriptor.variables["test"] == "test");
+        test(appObs2->inits == 0);
+        test(appObs2->dbSerial > dbSerial);
+        dbSerial = appObs2->dbSerial;
+        session2->destroy();
+
+        //
+        // An observer which is already up to date only receives the
+        // new updates.
+        //
+        {
+            ostringstream os;
+            os << dbSerial;
+            ctx["dbSerial.applications"] = os.str();
+        }
+        AdminSessionPrx session3 = registry->createAdminSession("admin1", "test1");
+        session3->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+        ApplicationObserverIPtr appObs3 = new ApplicationObserverI("appObs3.3");
+        Ice::ObjectPrx app3 = adpt1->addWithUUID(appObs3);
+        session3->setObserversByIdentity(Ice::Identity(),
+                                         Ice::Identity(),
+                                         app3->ice_getIdentity(),
+                                         Ice::Identity(),
+                                         Ice::Identity(),
+                                         ctx);
+        try
+        {
+            admin->removeApplication("Resume2");
+        }
+        catch(const Ice::UserException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        appObs3->waitForUpdate(__FILE__, __LINE__);
+        test(appObs3->serial == ++serial);
+        test(appObs3->inits == 0);
+        test(appObs3->dbSerial > dbSerial);
+        session3->destroy();
+
+        //
+        // Without the serial of its database, the observer receives
+        // the init call.
+        //
+        AdminSessionPrx session4 = registry->createAdminSession("admin1", "test1");
+        session4->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+        ApplicationObserverIPtr appObs4 = new ApplicationObserverI("appObs4.3");
+        Ice::ObjectPrx app4 = adpt1->addWithUUID(appObs4);
+        session4->setObserversByIdentity(Ice::Identity(),
+                                         Ice::Identity(),
+                                         app4->ice_getIdentity(),
+                                         Ice::Identity(),
+                                         Ice::Identity());
+        appObs4->waitForUpdate(__FILE__, __LINE__);
+        test(appObs4->inits == 1);
+        test(appObs4->serial == serial);
+        test(appObs4->applications.find("Resume1") != appObs4->applications.end());
+        test(appObs4->applications.find("Resume2") == appObs4->applications.end());
+        session4->destroy();
+
+        admin->removeApplication("Resume1");
+        adpt1->destroy();
+
+        cout << "ok" << endl;
+    }
+
     {
         cout << "testing adapter observer... " << flush;
 
@@ -1601,6 +1779,60 @@ allTests(const Ice::CommunicatorPtr& communicator)
             locatorRegistry->setAdapterDirectProxy("DummyAdapter", 0);
             adptObs1->waitForUpdate(__FILE__, __LINE__);
             test(adptObs1->adapters.find("DummyAdapter") == adptObs1->adapters.end());
+
+            //
+            // Concurrent registrations are committed together, each of
+            // them must still be committed and reported to the observer.
+            //
+            vector<string> ids;
+            vector<Ice::AsyncResultPtr> results;
+            for(int i = 0; i < 50; ++i)
+            {
+                ostringstream os;
+                os << "ConcurrentAdapter" << i;
+                ids.push_back(os.str());
+                results.push_back(locatorRegistry->begin_setAdapterDirectProxy(os.str(), obj));
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                locatorRegistry->end_setAdapterDirectProxy(*p);
+            }
+            for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+            {
+                adptObs1->waitForUpdate(__FILE__, __LINE__);
+            }
+            for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+            {
+                test(adptObs1->adapters[*p].proxy == obj);
+                test(admin->getAdapterInfo(*p)[0].proxy == obj);
+                test(communicator->getDefaultLocator()->findAdapterById(*p) == obj);
+            }
+
+            results.clear();
+            for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+            {
+                results.push_back(locatorRegistry->begin_setAdapterDirectProxy(*p, 0));
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                locatorRegistry->end_setAdapterDirectProxy(*p);
+            }
+            for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+            {
+                adptObs1->waitForUpdate(__FILE__, __LINE__);
+            }
+            for(vector<string>::const_iterator p = ids.begin(); p != ids.end(); ++p)
+            {
+                test(adptObs1->adapters.find(*p) == adptObs1->adapters.end());
+                try
+                {
+                    admin->getAdapterInfo(*p);
+                    test(false);
+                }
+                catch(const AdapterNotExistException&)
+                {
+                }
+            }
         }
         catch(const Ice::UserException& ex)
         {
@@ -2019,3 +2251,150 @@ allTests(const Ice::CommunicatorPtr& communicator)
 
     session->destroy();
 }
+
+void
+observerLimitsTests(const Ice::CommunicatorPtr& communicator)
+{
+    IceGrid::RegistryPrx registry = IceGrid::RegistryPrx::checkedCast(
+        communicator->stringToProxy(communicator->getDefaultLocator()->ice_getIdentity().category + "/Registry"));
+
+    AdminSessionPrx session = registry->createAdminSession("admin3", "test3");
+    session->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::ICE_ENUM(ACMHeartbeat, HeartbeatAlways));
+
+    AdminPrx admin = session->getAdmin();
+    test(admin);
+
+    Ice::LocatorRegistryPrx locatorRegistry = communicator->getDefaultLocator()->getRegistry();
+    Ice::ObjectPrx obj = communicator->stringToProxy("dummy:tcp -p 10000");
+
+    AdminSessionPrx session1 = registry->createAdminSession("admin1", "test1");
+    session1->ice_getConnection()->setACM(registry->getACMTimeout(), IceUtil::None, Ice::HeartbeatOnIdle);
+
+    Ice::ObjectAdapterPtr adpt1 = communicator->createObjectAdapter("");
+    adpt1->activate();
+    registry->ice_getConnection()->setAdapter(adpt1);
+
+    //
+    // The observer which is held must not block the dispatch of the
+    // other observers.
+    //
+    communicator->getProperties()->setProperty("HeldObserverAdapter.ThreadPool.Size", "1");
+    Ice::ObjectAdapterPtr adpt2 = communicator->createObjectAdapterWithEndpoints("HeldObserverAdapter", "default");
+    adpt2->activate();
+
+    AdapterObserverIPtr adptObs1 = new AdapterObserverI("adptObs1.4");
+    Ice::ObjectPrx adapter1 = adpt2->addWithUUID(adptObs1);
+
+    {
+        cout << "testing adapter observer paging... " << flush;
+
+        for(int i = 0; i < 5; ++i)
+        {
+            ostringstream os;
+            os << "PagedAdapter" << i;
+            locatorRegistry->setAdapterDirectProxy(os.str(), obj);
+        }
+
+        session1->setObservers(0, 0, 0, AdapterObserverPrx::uncheckedCast(adapter1), 0);
+        adptObs1->waitForUpdate(__FILE__, __LINE__); // init
+        test(adptObs1->inits == 1);
+        test(adptObs1->initSize == 2); // IceGrid.Registry.ObserverPageSize, see test.py
+
+        for(int i = 0; i < 5; ++i)
+        {
+            ostringstream os;
+            os << "PagedAdapter" << i;
+            while(adptObs1->adapters.find(os.str()) == adptObs1->adapters.end())
+            {
+                adptObs1->waitForUpdate(__FILE__, __LINE__);
+            }
+        }
+        test(adptObs1->inits == 1);
+
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing observer removal on queue overflow... " << flush;
+
+        //
+        // Hold the observer: the updates queue up in the registry until
+        // the observer is removed. IceGrid.Registry.ObserverQueueSizeMax
+        // is set to 5 by test.py.
+        //
+        adptObs1->hold(true);
+        for(int i = 0; i < 20; ++i)
+        {
+            ostringstream os;
+            os << "OverflowAdapter" << i;
+            locatorRegistry->setAdapterDirectProxy(os.str(), obj);
+        }
+        adptObs1->waitForUpdate(__FILE__, __LINE__); // The held update.
+        adptObs1->hold(false);
+
+        IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(1));
+        int received = 0;
+        for(int i = 0; i < 20; ++i)
+        {
+            ostringstream os;
+            os << "OverflowAdapter" << i;
+            if(adptObs1->adapters.find(os.str()) != adptObs1->adapters.end())
+            {
+                ++received;
+            }
+        }
+        test(received > 0 && received < 20);
+
+        //
+        // The removed observer can be set again with the serial of its
+        // last update to only receive the updates it missed.
+        //
+        Ice::Context ctx;
+        {
+            ostringstream os;
+            os << adptObs1->dbSerial;
+            ctx["dbSerial.adapters"] = os.str();
+        }
+        AdapterObserverIPtr adptObs2 = new AdapterObserverI("adptObs2.4");
+        Ice::ObjectPrx adapter2 = adpt1->addWithUUID(adptObs2);
+        session1->setObserversByIdentity(Ice::Identity(),
+                                         Ice::Identity(),
+                                         Ice::Identity(),
+                                         adapter2->ice_getIdentity(),
+                                         Ice::Identity(),
+                                         ctx);
+        for(int i = received; i < 20; ++i)
+        {
+            adptObs2->waitForUpdate(__FILE__, __LINE__);
+        }
+        test(adptObs2->inits == 0);
+        for(int i = 0; i < 20; ++i)
+        {
+            ostringstream os;
+            os << "OverflowAdapter" << i;
+            test((adptObs1->adapters.find(os.str()) != adptObs1->adapters.end()) !=
+                 (adptObs2->adapters.find(os.str()) != adptObs2->adapters.end()));
+        }
+
+        cout << "ok" << endl;
+    }
+
+    session1->destroy();
+    adpt1->destroy();
+    adpt2->destroy();
+
+    for(int i = 0; i < 5; ++i)
+    {
+        ostringstream os;
+        os << "PagedAdapter" << i;
+        admin->removeAdapter(os.str());
+    }
+    for(int i = 0; i < 20; ++i)
+    {
+        ostringstream os;
+        os << "OverflowAdapter" << i;
+        admin->removeAdapter(os.str());
+    }
+
+    session->destroy();
+}
@@ -16,7 +16,15 @@ int
 run(int, char**, const Ice::CommunicatorPtr& communicator)
 {
     void allTests(const Ice::CommunicatorPtr&);
-    allTests(communicator);
+    void observerLimitsTests(const Ice::CommunicatorPtr&);
+    if(communicator->getProperties()->getPropertyAsInt("ObserverLimits") > 0)
+    {
+        observerLimitsTests(communicator);
+    }
+    else
+    {
+        allTests(communicator);
+    }
     return EXIT_SUCCESS;
 }
 
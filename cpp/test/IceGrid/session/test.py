@@ -50,11 +50,24 @@ clientProps10 = lambda process, current: {
     "Ice.Default.EncodingVersion" : "1.0"
 }
 
+clientPropsLimits = lambda process, current: {
+    "ObserverLimits" : 1,
+}
+
+limitsRegistryProps = dict(registryProps)
+limitsRegistryProps.update({
+    'IceGrid.Registry.ObserverPageSize' : 2,
+    'IceGrid.Registry.ObserverQueueSizeMax' : 5,
+})
+
 icegridregistry = [IceGridRegistryMaster(props=registryProps)]
 
 TestSuite(__file__,
           [ IceGridSessionTestCase("with default encoding", icegridregistry=icegridregistry,
                                    client=IceGridClient(props=clientProps)),
             IceGridSessionTestCase("with 1.0 encoding", icegridregistry=icegridregistry,
-                                   client=IceGridClient(props=clientProps10))],
+                                   client=IceGridClient(props=clientProps10)),
+            IceGridSessionTestCase("with observer limits",
+                                   icegridregistry=[IceGridRegistryMaster(props=limitsRegistryProps)],
+                                   client=IceGridClient(props=clientPropsLimits))],
             runOnMainThread=True, multihost=False)
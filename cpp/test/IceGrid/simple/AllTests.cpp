@@ -16,6 +16,44 @@
 using namespace std;
 using namespace Test;
 
+namespace
+{
+
+class PingCountI : public TestIntf, public IceUtil::Mutex
+{
+public:
+
+    PingCountI() : _count(0)
+    {
+    }
+
+    virtual void
+    ice_ping(const Ice::Current&) const
+    {
+        Lock sync(*this);
+        ++_count;
+    }
+
+    virtual void
+    shutdown(const Ice::Current&)
+    {
+    }
+
+    int
+    getCount() const
+    {
+        Lock sync(*this);
+        return _count;
+    }
+
+private:
+
+    mutable int _count;
+};
+typedef IceUtil::Handle<PingCountI> PingCountIPtr;
+
+}
+
 void
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -48,6 +86,74 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(finder->getLocator());
     cout << "ok" << endl;
 
+    cout << "testing locator cache notifications... " << flush;
+    {
+        test(Ice::LocatorCacheNotifierPrx::checkedCast(communicator->getDefaultLocator(), "LocatorCache"));
+
+        //
+        // Without retries, a request sent to stale endpoints would fail
+        // instead of being transparently retried.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheNotifications", "1");
+        initData.properties->setProperty("Ice.RetryIntervals", "-1");
+        initData.properties->setProperty("NotifiedAdapter1.Endpoints", "default");
+        initData.properties->setProperty("NotifiedAdapter2.Endpoints", "default");
+        Ice::CommunicatorPtr notifiedCom = Ice::initialize(initData);
+
+        Ice::Identity id = Ice::stringToIdentity("notified");
+        PingCountIPtr servant1 = new PingCountI();
+        Ice::ObjectAdapterPtr adapter1 = notifiedCom->createObjectAdapter("NotifiedAdapter1");
+        adapter1->add(servant1, id);
+        adapter1->activate();
+        PingCountIPtr servant2 = new PingCountI();
+        Ice::ObjectAdapterPtr adapter2 = notifiedCom->createObjectAdapter("NotifiedAdapter2");
+        adapter2->add(servant2, id);
+        adapter2->activate();
+
+        Ice::LocatorRegistryPrx locatorRegistry = communicator->getDefaultLocator()->getRegistry();
+        locatorRegistry->setAdapterDirectProxy("notifiedAdapter", adapter1->createDirectProxy(id));
+
+        Ice::ObjectPrx notified = notifiedCom->stringToProxy("notified @ notifiedAdapter");
+        notified = notified->ice_collocationOptimized(false);
+        notified->ice_ping();
+        test(servant1->getCount() == 1);
+
+        //
+        // Move the adapter to the second object adapter: the first one is
+        // still reachable, only the notification of the registry (or the
+        // cache clear once the observer is added) can prevent the client
+        // from using its cached endpoints. The requests are sent until one
+        // reaches the second adapter.
+        //
+        locatorRegistry->setAdapterDirectProxy("notifiedAdapter", adapter2->createDirectProxy(id));
+        IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(10);
+        while(true)
+        {
+            notified->ice_ping();
+            if(servant2->getCount() > 0)
+            {
+                break;
+            }
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) < deadline);
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(servant2->getCount() == 1);
+
+        //
+        // Once notified, the requests keep using the new endpoints.
+        //
+        int count = servant1->getCount();
+        notified->ice_ping();
+        test(servant1->getCount() == count);
+        test(servant2->getCount() == 2);
+
+        locatorRegistry->setAdapterDirectProxy("notifiedAdapter", 0);
+        notifiedCom->destroy();
+    }
+    cout << "ok" << endl;
+
     Ice::CommunicatorPtr com;
     try
     {
@@ -1093,6 +1093,134 @@ allTests(const Ice::CommunicatorPtr& communicator)
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing parallel instantiation... " << flush;
+
+        //
+        // The registries are configured to instantiate the nodes of
+        // applications with more than 20 servers in parallel.
+        //
+        ServerDescriptorPtr server = new ServerDescriptor();
+        server->id = "${node}-${index}";
+        server->exe = "server";
+        server->pwd = ".";
+        server->applicationDistrib = false;
+        server->allocatable = false;
+        addProperty(server, "ApplicationVar", "${appvar}");
+        addProperty(server, "NodeVar", "${nodevar}");
+        addProperty(server, "TemplateVar", "1");
+
+        TemplateDescriptor templ;
+        templ.parameters.push_back("index");
+        templ.descriptor = server;
+
+        ApplicationDescriptor testApp;
+        testApp.name = "TestApp";
+        testApp.variables["appvar"] = "AppValue";
+        testApp.serverTemplates["ServerTemplate"] = templ;
+        const char* nodes[] = { "node-a", "node-b", "node-c" };
+        for(int i = 0; i < 3; ++i)
+        {
+            NodeDescriptor node;
+            node.variables["nodevar"] = nodes[i];
+            for(int j = 0; j < 10; ++j)
+            {
+                ServerInstanceDescriptor instance;
+                instance._cpp_template = "ServerTemplate";
+                ostringstream os;
+                os << j;
+                instance.parameterValues["index"] = os.str();
+                node.serverInstances.push_back(instance);
+            }
+            testApp.nodes[nodes[i]] = node;
+        }
+
+        try
+        {
+            admin->addApplication(testApp);
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        for(int i = 0; i < 3; ++i)
+        {
+            for(int j = 0; j < 10; ++j)
+            {
+                ostringstream os;
+                os << nodes[i] << "-" << j;
+                ServerInfo info = admin->getServerInfo(os.str());
+                test(info.node == nodes[i]);
+                test(hasProperty(info.descriptor, "ApplicationVar", "AppValue"));
+                test(hasProperty(info.descriptor, "NodeVar", nodes[i]));
+                test(hasProperty(info.descriptor, "TemplateVar", "1"));
+            }
+        }
+
+        //
+        // Updating a node reuses the instantiation of the other nodes.
+        //
+        ApplicationUpdateDescriptor empty;
+        empty.name = "TestApp";
+        ApplicationUpdateDescriptor update = empty;
+        NodeUpdateDescriptor nodeUpdate;
+        nodeUpdate.name = "node-b";
+        nodeUpdate.variables["nodevar"] = "updated";
+        update.nodes.push_back(nodeUpdate);
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("node-a-3").descriptor, "NodeVar", "node-a"));
+        test(hasProperty(admin->getServerInfo("node-b-3").descriptor, "NodeVar", "updated"));
+        test(hasProperty(admin->getServerInfo("node-c-3").descriptor, "NodeVar", "node-c"));
+
+        //
+        // Updating an application variable or a template invalidates
+        // the instantiation of all the nodes.
+        //
+        update = empty;
+        update.variables["appvar"] = "UpdatedAppValue";
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("node-a-5").descriptor, "ApplicationVar", "UpdatedAppValue"));
+        test(hasProperty(admin->getServerInfo("node-c-9").descriptor, "ApplicationVar", "UpdatedAppValue"));
+
+        update = empty;
+        server = ServerDescriptorPtr::dynamicCast(server->ice_clone());
+        server->propertySet.properties.back().value = "2";
+        templ.descriptor = server;
+        update.serverTemplates["ServerTemplate"] = templ;
+        admin->updateApplication(update);
+        test(hasProperty(admin->getServerInfo("node-a-0").descriptor, "TemplateVar", "2"));
+        test(hasProperty(admin->getServerInfo("node-b-7").descriptor, "TemplateVar", "2"));
+        test(hasProperty(admin->getServerInfo("node-c-2").descriptor, "TemplateVar", "2"));
+
+        //
+        // An instantiation error of a node is raised and the application
+        // isn't updated.
+        //
+        update = empty;
+        nodeUpdate = NodeUpdateDescriptor();
+        nodeUpdate.name = "node-c";
+        ServerInstanceDescriptor instance;
+        instance._cpp_template = "ServerTemplate";
+        nodeUpdate.serverInstances.push_back(instance);
+        update.nodes.push_back(nodeUpdate);
+        update.variables["appvar"] = "FailedAppValue";
+        try
+        {
+            admin->updateApplication(update);
+            test(false);
+        }
+        catch(const DeploymentException&)
+        {
+            // Missing parameter
+        }
+        test(hasProperty(admin->getServerInfo("node-a-5").descriptor, "ApplicationVar", "UpdatedAppValue"));
+
+        admin->removeApplication("TestApp");
+        cout << "ok" << endl;
+    }
+
     {
         cout << "testing server node move... " << flush;
 
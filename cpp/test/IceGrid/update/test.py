@@ -23,4 +23,13 @@ clientProps = lambda process, current: {
     "TestDir" : "{testdir}"
 }
 
-TestSuite(__file__, [IceGridUpdateTestCase(application=None, client=IceGridClient(props=clientProps))], multihost=False)
\ No newline at end of file
+#
+# Instantiate the nodes of applications with more than 20 servers in
+# parallel to test the parallel instantiation with small applications.
+#
+registryProps = { "IceGrid.Registry.ParallelInstantiationThreshold" : 20 }
+
+icegridregistry = [IceGridRegistryMaster(props=registryProps), IceGridRegistrySlave(1, props=registryProps)]
+
+TestSuite(__file__, [IceGridUpdateTestCase(application=None, icegridregistry=icegridregistry,
+                                           client=IceGridClient(props=clientProps))], multihost=False)
\ No newline at end of file
@@ -0,0 +1,263 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// The number of events published by each step of the test. The large
+// events fill several log segments (IceStorm.Durable.SegmentSize=1)
+// and the oldest segments are removed (IceStorm.Durable.MaxSegments=2).
+//
+const int nevents = 100;
+const int nlive = 10;
+const int nlarge = 48;
+const int largeSize = 64 * 1024;
+
+class EventI : public Blobject, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual bool
+    ice_invoke(const vector<Byte>&, vector<Byte>&, const Current& current)
+    {
+        Context::const_iterator p = current.ctx.find("IceStorm.Sequence");
+        test(p != current.ctx.end());
+        Long seq;
+        istringstream is(p->second);
+        test(is >> seq);
+
+        Lock sync(*this);
+        _sequences.push_back(seq);
+        notifyAll();
+        return true;
+    }
+
+    vector<Long>
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_sequences.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(30)))
+            {
+                test(false);
+            }
+        }
+        return _sequences;
+    }
+
+    vector<Long>
+    waitForLastEvent(Long last)
+    {
+        Lock sync(*this);
+        while(_sequences.empty() || _sequences.back() < last)
+        {
+            if(!timedWait(IceUtil::Time::seconds(30)))
+            {
+                test(false);
+            }
+        }
+        return _sequences;
+    }
+
+private:
+
+    vector<Long> _sequences;
+};
+typedef IceUtil::Handle<EventI> EventIPtr;
+
+void
+publish(const TopicPrx& topic, int count, int size)
+{
+    vector<Byte> inParams;
+    OutputStream out(topic->ice_getCommunicator());
+    out.startEncapsulation();
+    out.write(vector<Byte>(size));
+    out.endEncapsulation();
+    out.finished(inParams);
+
+    ObjectPrx publisher = topic->getPublisher();
+    vector<Byte> outParams;
+    for(int i = 0; i < count; ++i)
+    {
+        test(publisher->ice_invoke("event", Normal, inParams, outParams));
+    }
+}
+
+ObjectPrx
+subscribe(const TopicPrx& topic, const ObjectAdapterPtr& adapter, const EventIPtr& servant, const string& resumeFrom)
+{
+    QoS qos;
+    qos["reliability"] = "ordered";
+    qos["resumeFrom"] = resumeFrom;
+    ObjectPrx subscriber = adapter->addWithUUID(servant);
+    topic->subscribeAndGetPublisher(qos, subscriber);
+    return subscriber;
+}
+
+void
+testSequences(const vector<Long>& sequences, Long first, Long last)
+{
+    test(!sequences.empty());
+    test(sequences.front() == first);
+    test(sequences.back() == last);
+    test(sequences.size() == static_cast<size_t>(last - first + 1));
+    for(size_t i = 1; i < sequences.size(); ++i)
+    {
+        test(sequences[i] == sequences[i - 1] + 1);
+    }
+}
+
+}
+
+int
+run(int argc, char* argv[], const CommunicatorPtr& communicator)
+{
+    string proxy = communicator->getProperties()->getProperty("IceStormAdmin.TopicManager.Default");
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(proxy));
+    if(!manager)
+    {
+        cerr << argv[0] << ": `" << proxy << "' is not running" << endl;
+        return EXIT_FAILURE;
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+    adapter->activate();
+
+    const Long nlogged = nevents + nlive + nlarge;
+
+    if(argc > 1 && string(argv[1]) == "publish")
+    {
+        TopicPrx topic = manager->create("durable");
+
+        cout << "testing resumeFrom QoS validation... " << flush;
+        {
+            TopicPrx other = manager->create("other");
+            try
+            {
+                subscribe(other, adapter, new EventI, "1");
+                test(false);
+            }
+            catch(const BadQoS&)
+            {
+            }
+            other->destroy();
+
+            const char* invalid[] = { "0", "-1", "abc", "1x" };
+            for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+            {
+                try
+                {
+                    subscribe(topic, adapter, new EventI, invalid[i]);
+                    test(false);
+                }
+                catch(const BadQoS&)
+                {
+                }
+            }
+        }
+        cout << "ok" << endl;
+
+        cout << "testing replay of logged events... " << flush;
+        {
+            publish(topic, nevents, 0);
+
+            EventIPtr servant = new EventI;
+            ObjectPrx subscriber = subscribe(topic, adapter, servant, "1");
+            testSequences(servant->waitForEvents(nevents), 1, nevents);
+
+            //
+            // Events published after the subscription follow the replayed
+            // events, without duplicates.
+            //
+            publish(topic, nlive, 0);
+            testSequences(servant->waitForEvents(nevents + nlive), 1, nevents + nlive);
+            topic->unsubscribe(subscriber);
+
+            servant = new EventI;
+            subscriber = subscribe(topic, adapter, servant, "50");
+            testSequences(servant->waitForEvents(nevents + nlive - 49), 50, nevents + nlive);
+            topic->unsubscribe(subscriber);
+        }
+        cout << "ok" << endl;
+
+        cout << "testing log segment rotation... " << flush;
+        {
+            publish(topic, nlarge, largeSize);
+
+            //
+            // The oldest events were removed with their segments, the
+            // replay starts with the oldest event still logged.
+            //
+            EventIPtr servant = new EventI;
+            ObjectPrx subscriber = subscribe(topic, adapter, servant, "1");
+            vector<Long> sequences = servant->waitForLastEvent(nlogged);
+            test(sequences.front() > nevents + nlive);
+            testSequences(sequences, sequences.front(), nlogged);
+            topic->unsubscribe(subscriber);
+        }
+        cout << "ok" << endl;
+    }
+    else if(argc > 1 && string(argv[1]) == "recover")
+    {
+        //
+        // IceStorm was restarted with a partially written record at the
+        // end of the log, the record must be dropped.
+        //
+        cout << "testing log recovery... " << flush;
+        TopicPrx topic = manager->retrieve("durable");
+
+        EventIPtr servant = new EventI;
+        ObjectPrx subscriber = subscribe(topic, adapter, servant, "150");
+        testSequences(servant->waitForEvents(static_cast<size_t>(nlogged - 149)), 150, nlogged);
+
+        publish(topic, 1, 0);
+        testSequences(servant->waitForEvents(static_cast<size_t>(nlogged - 148)), 150, nlogged + 1);
+        topic->unsubscribe(subscriber);
+
+        topic->destroy();
+        cout << "ok" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+    InitializationData initData = getTestInitData(argc, argv);
+    try
+    {
+        communicator = initialize(argc, argv, initData);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        communicator->destroy();
+    }
+
+    return status;
+}
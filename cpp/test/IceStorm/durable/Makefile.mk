@@ -0,0 +1,16 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+$(test)_dependencies 	= IceStorm Ice TestCommon
+
+$(test)_client_sources 	= Client.cpp
+
+$(test)_cleanfiles = db/*
+
+tests += $(test)
\ No newline at end of file
@@ -0,0 +1,51 @@
+# -*- coding: utf-8 -*-
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+import struct
+
+class DurableClient(IceStormProcess, Client):
+
+    def __init__(self, *args, **kargs):
+        Client.__init__(self, *args, **kargs)
+        IceStormProcess.__init__(self)
+
+    getParentProps = Client.getProps # Used by IceStormProcess to get the client properties
+
+class IceStormDurableTestCase(IceStormTestCase):
+
+    def runClientSide(self, current):
+
+        DurableClient(args=["publish"]).run(current)
+
+        #
+        # Simulate a crash while an event was written: append a partially
+        # written record to the last segment of the topic log, it must be
+        # dropped when IceStorm is restarted.
+        #
+        current.write("restarting IceStorm with a partially written event... ")
+        self.stopIceStorm(current)
+        path = os.path.join(self.icestorm[0].dbdir, "events", "durable")
+        segment = sorted([f for f in os.listdir(path) if f.endswith(".log")])[-1]
+        with open(os.path.join(path, segment), "ab") as f:
+            f.write(struct.pack("<iq", 1000, 159) + b"partial")
+        self.startIceStorm(current)
+        current.writeln("ok")
+
+        DurableClient(args=["recover"]).run(current)
+
+props = {
+    "IceStorm.Durable.Topics" : "durable",
+    "IceStorm.Durable.SegmentSize" : 1,
+    "IceStorm.Durable.MaxSegments" : 2,
+}
+
+TestSuite(__file__, [
+    IceStormDurableTestCase("persistent", icestorm=IceStorm(props=props, quiet=True)),
+], multihost=False)
@@ -18,7 +18,8 @@
 props = {
     "IceStorm.Election.MasterTimeout" : 2,
     "IceStorm.Election.ElectionTimeout" : 2,
-    "IceStorm.Election.ResponseTimeout" : 2
+    "IceStorm.Election.ResponseTimeout" : 2,
+    "IceStorm.Replication.ChunkSize" : 1 # Send the topic content in several chunks
 }
 
 icestorm = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
@@ -0,0 +1,165 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <TestCommon.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+
+namespace
+{
+
+const int ntopics = 20;
+
+string
+topicName(int i)
+{
+    ostringstream os;
+    os << "shard" << i;
+    return os.str();
+}
+
+TopicManagerPrx
+getManager(const CommunicatorPtr& communicator, const string& name)
+{
+    string proxy = communicator->getProperties()->getProperty("IceStormAdmin.TopicManager." + name);
+    TopicManagerPrx manager = TopicManagerPrx::checkedCast(communicator->stringToProxy(proxy));
+    if(!manager)
+    {
+        cerr << "`" << proxy << "' is not running" << endl;
+        test(false);
+    }
+    return manager;
+}
+
+}
+
+int
+run(int argc, char* argv[], const CommunicatorPtr& communicator)
+{
+    TopicManagerPrx manager1 = getManager(communicator, "TestIceStorm1");
+    TopicManagerPrx manager2 = getManager(communicator, "TestIceStorm2");
+
+    if(argc > 1 && string(argv[1]) == "create")
+    {
+        //
+        // Create the topics through the first shard, each topic must
+        // be created on the shard that owns it.
+        //
+        cout << "testing topic creation... " << flush;
+        set<string> categories;
+        for(int i = 0; i < ntopics; ++i)
+        {
+            TopicPrx topic = manager1->create(topicName(i));
+            test(topic->getName() == topicName(i));
+            categories.insert(topic->ice_getIdentity().category);
+
+            try
+            {
+                manager2->create(topicName(i));
+                test(false);
+            }
+            catch(const TopicExists& ex)
+            {
+                test(ex.name == topicName(i));
+            }
+        }
+        test(categories.size() == 2);
+        cout << "ok" << endl;
+    }
+
+    //
+    // Both shards must return the same topic and each topic must only
+    // be listed by the shard that owns it.
+    //
+    cout << "testing topic retrieval... " << flush;
+    TopicDict topics1 = manager1->retrieveAll();
+    TopicDict topics2 = manager2->retrieveAll();
+    test(topics1.size() + topics2.size() == ntopics);
+    for(int i = 0; i < ntopics; ++i)
+    {
+        TopicPrx topic = manager1->retrieve(topicName(i));
+        test(topic == manager2->retrieve(topicName(i)));
+        test(topics1.find(topicName(i)) != topics1.end() || topics2.find(topicName(i)) != topics2.end());
+    }
+    cout << "ok" << endl;
+
+    if(argc > 1 && string(argv[1]) == "destroy")
+    {
+        cout << "destroying topics... " << flush;
+        for(int i = 0; i < ntopics; ++i)
+        {
+            manager2->retrieve(topicName(i))->destroy();
+            try
+            {
+                manager1->retrieve(topicName(i));
+                test(false);
+            }
+            catch(const NoSuchTopic&)
+            {
+            }
+        }
+        cout << "ok" << endl;
+
+        //
+        // A request forwarded by another shard is handled by the shard
+        // which receives it, even if it doesn't own the topic, it's
+        // never forwarded again.
+        //
+        cout << "testing forwarded requests... " << flush;
+        string name;
+        for(int i = 0; i < ntopics && name.empty(); ++i)
+        {
+            if(topics2.find(topicName(i)) != topics2.end())
+            {
+                name = topicName(i);
+            }
+        }
+        test(!name.empty());
+        Ice::Context ctx;
+        ctx["IceStorm.ForwardedByShard"] = "TestIceStorm2";
+        TopicPrx topic = manager1->create(name, ctx);
+        test(manager1->retrieve(name, ctx) == topic);
+        topics1 = manager1->retrieveAll();
+        topics2 = manager2->retrieveAll();
+        test(topics1.find(name) != topics1.end() && topics2.find(name) == topics2.end());
+        topic->destroy();
+        cout << "ok" << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+    int status;
+    CommunicatorPtr communicator;
+    InitializationData initData = getTestInitData(argc, argv);
+    try
+    {
+        communicator = initialize(argc, argv, initData);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        communicator->destroy();
+    }
+
+    return status;
+}
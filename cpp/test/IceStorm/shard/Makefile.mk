@@ -0,0 +1,16 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+$(test)_dependencies 	= IceStorm Ice TestCommon
+
+$(test)_client_sources 	= Client.cpp
+
+$(test)_cleanfiles = db/* 0.db/* 1.db/* 2.db/* db2/* 0.db2/* 1.db2/* 2.db2/*
+
+tests += $(test)
\ No newline at end of file
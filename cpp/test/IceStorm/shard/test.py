@@ -0,0 +1,74 @@
+# -*- coding: utf-8 -*-
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+#
+# IceStorm service configured as a shard of a deployment made of the
+# TestIceStorm1 and TestIceStorm2 instance(s).
+#
+class ShardedIceStorm(IceStorm):
+
+    def getProps(self, current):
+        props = IceStorm.getProps(self, current)
+        testcase = current.testcase
+        while testcase and not isinstance(testcase, IceStormTestCase): testcase = testcase.parent
+        props["IceStorm.Shard.Name"] = self.instanceName
+        for name in testcase.getInstanceNames():
+            props["IceStorm.Shards.{0}".format(name)] = testcase.getTopicManager(current, name)
+        return props
+
+class ShardClient(IceStormProcess, Client):
+
+    def __init__(self, *args, **kargs):
+        Client.__init__(self, *args, **kargs)
+        IceStormProcess.__init__(self)
+
+    getParentProps = Client.getProps # Used by IceStormProcess to get the client properties
+
+class IceStormShardTestCase(IceStormTestCase):
+
+    def runClientSide(self, current):
+
+        ShardClient(args=["create"]).run(current)
+
+        if self.getName().find("replicated") >= 0:
+            #
+            # Stop the first replica of each shard, the topics must
+            # still be reachable through the remaining replicas.
+            #
+            current.write("stopping the first replica of each shard... ")
+            for icestorm in [icestorm for icestorm in self.icestorm if icestorm.replica == 0]:
+                icestorm.shutdown(current)
+                icestorm.stop(current, True)
+            current.writeln("ok")
+        else:
+            current.write("restarting IceStorm servers... ")
+            self.restartIceStorm(current)
+            current.writeln("ok")
+
+        ShardClient(args=["destroy"]).run(current)
+
+props = {
+    "IceStorm.Election.MasterTimeout" : 2,
+    "IceStorm.Election.ElectionTimeout" : 2,
+    "IceStorm.Election.ResponseTimeout" : 2
+}
+
+TestSuite(__file__, [
+
+    IceStormShardTestCase("persistent", icestorm=
+                          [ShardedIceStorm("TestIceStorm1", quiet=True),
+                           ShardedIceStorm("TestIceStorm2", quiet=True, portnum=20)]),
+
+    IceStormShardTestCase("replicated", icestorm=
+                          [ShardedIceStorm("TestIceStorm1", i, 3, quiet=True, props=props) for i in range(0,3)] +
+                          [ShardedIceStorm("TestIceStorm2", i, 3, quiet=True, portnum=20, props=props)
+                           for i in range(0,3)]),
+
+], multihost=False)
\ No newline at end of file
@@ -25,7 +25,10 @@ public:
         _communicator(communicator),
         _name(name),
         _count(0),
-        _last(0)
+        _last(0),
+        _latest(false),
+        _latestEvent(-1),
+        _sequence(0)
     {
     }
 
@@ -52,11 +55,56 @@ public:
             cerr << endl << "expected datagram to be received over udp";
             test(false);
         }
+        if(_name == "conflate")
+        {
+            //
+            // A slow subscriber, the events queued while an event is
+            // being dispatched are conflated.
+            //
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
         Lock sync(*this);
         if(_name == "per-request load balancing")
         {
             _connections.insert(current.con);
         }
+        if(_name.compare(0, 9, "multicast") == 0)
+        {
+            if(current.con->type() != "udp")
+            {
+                cerr << endl << "expected multicast to be received over udp";
+                test(false);
+            }
+
+            // Events are sent once to the group with increasing sequence numbers.
+            Ice::Context::const_iterator p = current.ctx.find("IceStorm.MulticastSequence");
+            test(p != current.ctx.end());
+            Ice::Long sequence = 0;
+            istringstream is(p->second);
+            test(is >> sequence);
+            test(sequence > _sequence);
+            _sequence = sequence;
+        }
+        if(_name == "conflate")
+        {
+            //
+            // Older events are replaced by newer ones: the events are
+            // received in order and the latest event is always delivered.
+            //
+            if(i <= _latestEvent)
+            {
+                cerr << endl << "received conflated event " << i << " after event " << _latestEvent;
+                test(false);
+            }
+            _latestEvent = i;
+            ++_count;
+            if(i == 999)
+            {
+                _latest = true;
+                notify();
+            }
+            return;
+        }
         ++_last;
         if(++_count == 1000)
         {
@@ -69,7 +117,26 @@ public:
     {
         Lock sync(*this);
         cout << "testing " << _name << " ... " << flush;
-        bool datagram = _name == "datagram" || _name == "batch datagram";
+        if(_name == "filtered out")
+        {
+            test(_count == 0);
+            cout << "ok" << endl;
+            return;
+        }
+        if(_name == "conflate")
+        {
+            while(!_latest)
+            {
+                if(!timedWait(IceUtil::Time::seconds(20)))
+                {
+                    test(false);
+                }
+            }
+            test(_count < 1000);
+            cout << "ok" << endl;
+            return;
+        }
+        bool datagram = _name == "datagram" || _name == "batch datagram" || _name.compare(0, 9, "multicast") == 0;
         IceUtil::Time timeout = (datagram) ? IceUtil::Time::seconds(5) : IceUtil::Time::seconds(20);
         while(_count < 1000)
         {
@@ -106,6 +173,9 @@ private:
     const string _name;
     int _count;
     int _last;
+    bool _latest;
+    int _latestEvent;
+    Ice::Long _sequence;
     set<Ice::ConnectionPtr> _connections;
 };
 typedef IceUtil::Handle<SingleI> SingleIPtr;
@@ -223,6 +293,65 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         subscriberIdentities.push_back(object->ice_getIdentity());
         topic->subscribeAndGetPublisher(qos, object);
     }
+    {
+        subscribers.push_back(new SingleI(communicator, "filtered"));
+        IceStorm::QoS qos;
+        qos["filter"] = "op in (event, other); ctx.region != eu";
+        Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
+    {
+        // Use a separate adapter, the conflate subscriber is slow and
+        // must not hold the dispatch of the other subscribers.
+        communicator->getProperties()->setProperty("ConflateAdapter.ThreadPool.Size", "1");
+        ObjectAdapterPtr adpt = communicator->createObjectAdapterWithEndpoints("ConflateAdapter", "default");
+        subscribers.push_back(new SingleI(communicator, "conflate"));
+        IceStorm::QoS qos;
+        qos["reliability"] = "conflate";
+        Ice::ObjectPrx object = adpt->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        adpt->activate();
+        topic->subscribeAndGetPublisher(qos, object);
+    }
+    {
+        Ice::ObjectPrx object = adapter->addWithUUID(new SingleI(communicator, "invalid filter"));
+        IceStorm::QoS qos;
+        qos["filter"] = "event";
+        try
+        {
+            topic->subscribeAndGetPublisher(qos, object);
+            test(false);
+        }
+        catch(const IceStorm::BadQoS&)
+        {
+        }
+    }
+    {
+        Ice::ObjectPrx object = adapter->addWithUUID(new SingleI(communicator, "send queue size max"));
+        const char* invalid[] = { "0", "-2", "ten", "10 events" };
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+        {
+            IceStorm::QoS qos;
+            qos["sendQueueSizeMax"] = invalid[i];
+            try
+            {
+                topic->subscribeAndGetPublisher(qos, object);
+                test(false);
+            }
+            catch(const IceStorm::BadQoS&)
+            {
+            }
+        }
+
+        IceStorm::QoS qos;
+        qos["sendQueueSizeMax"] = "-1";
+        topic->subscribeAndGetPublisher(qos, object);
+        topic->unsubscribe(object);
+        qos["sendQueueSizeMax"] = " 10 ";
+        topic->subscribeAndGetPublisher(qos, object);
+        topic->unsubscribe(object);
+    }
     {
         // Use a separate adapter to ensure a separate connection is used for the subscriber
         // (otherwise, if multiple UDP subscribers use the same connection we might get high
@@ -248,6 +377,49 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         topic->subscribeAndGetPublisher(IceStorm::QoS(), object);
     }
 
+    {
+        //
+        // Two subscribers joining the same multicast group, the events
+        // are sent once to the group and received by both.
+        //
+        ostringstream endpoint;
+        if(properties->getProperty("Ice.IPv6") == "1")
+        {
+            endpoint << "udp -h \"ff15::1:1\" -p " << getTestPort(properties, 20);
+#ifdef __APPLE__
+            endpoint << " --interface \"::1\"";
+#endif
+        }
+        else
+        {
+            endpoint << "udp -h 239.255.1.1 -p " << getTestPort(properties, 20);
+        }
+
+        IceStorm::QoS qos;
+        qos["multicast"] = "single -d:" + endpoint.str();
+        for(int i = 0; i < 2; ++i)
+        {
+            ostringstream name;
+            name << "McastAdapter" << i;
+            communicator->getProperties()->setProperty(name.str() + ".ThreadPool.Size", "1");
+            ObjectAdapterPtr adpt = communicator->createObjectAdapterWithEndpoints(name.str(), endpoint.str());
+            subscribers.push_back(new SingleI(communicator, i == 0 ? "multicast" : "multicast 2"));
+            adpt->add(subscribers.back(), Ice::stringToIdentity("single"));
+            adpt->activate();
+            Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+            subscriberIdentities.push_back(object->ice_getIdentity());
+            topic->subscribeAndGetPublisher(qos, object);
+        }
+    }
+    {
+        subscribers.push_back(new SingleI(communicator, "filtered out"));
+        IceStorm::QoS qos;
+        qos["filter"] = "op = other";
+        Ice::ObjectPrx object = adapter->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+    }
+
     adapter->activate();
 
     vector<Ice::Identity> ids = topic->getSubscribers();
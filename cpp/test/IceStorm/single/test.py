@@ -20,7 +20,8 @@
 #
 props = { "Ice.UDP.SndSize" : 2048, "Ice.Warn.Dispatch" : 0 }
 persistent = IceStorm(props = props)
-transient = IceStorm(props = props, transient=True)
+# Also test adaptive flushing of batch subscribers with the transient service.
+transient = IceStorm(props = dict(props, **{ "IceStorm.Flush.Adaptive" : 1 }), transient=True)
 replicated = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
 sub = Subscriber(args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 4096 }, readyCount=2)
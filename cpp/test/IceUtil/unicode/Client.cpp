@@ -215,6 +215,28 @@ main(int argc, char* argv[])
 
         cout << "ok" << endl;
 
+        cout << "testing wstring with ASCII characters... ";
+
+        //
+        // The conversion of the leading ASCII characters is optimized, check
+        // ASCII strings of various lengths with non-ASCII characters at
+        // various positions.
+        //
+        for(size_t i = 0; i < 20; ++i)
+        {
+            wstring ascii;
+            for(size_t j = 0; j < i; ++j)
+            {
+                ascii += static_cast<wchar_t>(L'a' + j);
+            }
+            test(stringToWstring(wstringToString(ascii)) == ascii);
+
+            wstring mixed = ascii + L"\u20ac" + ascii + L"\U00010437" + ascii;
+            test(stringToWstring(wstringToString(mixed)) == mixed);
+        }
+
+        cout << "ok" << endl;
+
         cout << "testing IceUtilInternal::toUTF16, toUTF32 and fromUTF32... ";
 
         vector<Byte> u8 = vector<Byte>(reinterpret_cast<const Byte*>(ns.data()),
@@ -288,6 +310,8 @@ main(int argc, char* argv[])
             "\xf0\x28\x8c\x28",
             "\xf8\xa1\xa1\xa1\xa1",
             "\xfc\xa1\xa1\xa1\xa1\xa1",
+            "abcdefghijklmnop\xc3\x28",
+            "abcdefghijklmnop\xe2\x82\x28",
             ""
         };
 
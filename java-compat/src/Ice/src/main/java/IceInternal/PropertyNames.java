@@ -125,6 +125,7 @@ public final class PropertyNames
         new Property("Ice\\.InitPlugins", false, null),
         new Property("Ice\\.IPv4", false, null),
         new Property("Ice\\.IPv6", false, null),
+        new Property("Ice\\.LocatorCacheNotifications", false, null),
         new Property("Ice\\.LogFile", false, null),
         new Property("Ice\\.LogFile\\.SizeMax", false, null),
         new Property("Ice\\.LogStdErr\\.Convert", false, null),